@@ -1,449 +1,592 @@
 #include <furi.h>          // Core Flipper Zero system library
+#include <furi_hal.h>      // Hardware RNG for the seed
 #include <gui/gui.h>       // GUI system for display rendering
 #include <input/input.h>   // Input handling for button events
-#include <gui/elements.h>  // GUI elements library for button hints and UI components
-#include <stdlib.h>        // Standard library for rand(), malloc(), etc.
-#include <math.h>
-#include "mitzi_hirn_icons.h"
+#include <stdlib.h>        // Standard library for malloc(), free(), etc.
+#include "hirn_game.h"     // Game core: state, scoring and transitions
+#include "hirn_code.h"     // Packed codes and feedback classes
+#include "hirn_candidates.h" // Secrets still consistent with the history
+#include "hirn_solver.h"    // Hint search
+#include "hirn_book.h"      // Precomputed hints for the first two turns
+#include "hirn_sprite.h"    // Pre-rasterized peg patterns
+#include "hirn_snapshot.h"  // State handed to the draw callback
+#include "hirn_view.h"      // The game screen
+#include "hirn_profile.h"   // Optional timing, see HIRN_PROFILE
 
 #define TAG "Hirn"  // Tag for logging
 
-#define COLOR_REPEAT false  // Whether colors can repeat in the secret code
-#define NUM_COLORS 6        // Number of available colors
-#define NUM_PEGS 4          // Number of pegs in the code
-#define PEG_Y_POSITION 22   // Vertical position for current guessing pegs
-#define PEG_X_POSITION 10   // Horizontal position
-#define FEEDBACK_RADIUS 3   
-#define MAX_ATTEMPTS 20     // Maximum number of guessing attempts
-#define CURSOR_SIZE 20      // Size of cursor box (width and height)
-#define HUD_X_POSITION 65   // X position for HUD (timer and attempts counter)
-#define MAX_TIME_MS (20 * 60 * 1000)  // Maximum time in milliseconds
+#define HINT_STACK_SIZE 1024 // Stack of the hint worker thread, the search allocates on the heap
+#define HINT_PROGRESS_MS 100 // Progress refresh while a hint search runs
+#define APP_STACK_SIZE (2 * 1024) // stack_size in application.fam, shown by the debug overlay
+#define EVENT_QUEUE_SIZE 8 // Events the main loop takes in one go
+#define HISTORY_GLIDE_PX 4 // History scroll per repeat of a held Up/Down
 
 // ============================================================================
-// Enumerations
+// Data Structures
 // ============================================================================
 
-// Color patterns (fill styles)
-typedef enum {
-    COLOR_NONE = 0,  // Empty/unfilled
-    COLOR_RED,       // Solid fill
-    COLOR_GREEN,     // Horizontal lines
-    COLOR_BLUE,      // Vertical lines
-    COLOR_YELLOW,    // Diagonal lines (/)
-    COLOR_PURPLE,    // Diagonal lines (\)
-    COLOR_ORANGE     // Cross-hatch
-} PegColor;
-
-// Feedback peg types
+// Events in the app's message queue
 typedef enum {
-    FEEDBACK_NONE = 0,   // No feedback
-    FEEDBACK_BLACK,      // Correct color, correct position
-    FEEDBACK_WHITE       // Correct color, wrong position
-} FeedbackType;
+    EventTypeInput,
+    EventTypeHint,   // The hint worker finished
+    EventTypeClock,  // The play time reached a whole second
+} HirnEventType;
 
-// Game states
-typedef enum {
-    STATE_PLAYING,
-    STATE_PAUSED,
-    STATE_WON,
-    STATE_LOST,
-    STATE_REVEAL
-} GameState;
+typedef struct {
+    uint32_t generation;  // Search the result belongs to
+    HirnHint hint;
+    bool found;           // False if there was nothing to search
+} HirnHintResult;
 
-// ============================================================================
-// Data Structures
-// ============================================================================
+typedef struct {
+    HirnEventType type;
+    union {
+        InputEvent input;
+        HirnHintResult hint;
+    };
+#ifdef HIRN_PROFILE
+    uint32_t stamp;  // hirn_profile_now() when the input arrived
+#endif
+} HirnEvent;
 
-// Application state
+#ifdef HIRN_DEBUG_OVERLAY
+// Frame stats of the debug overlay
 typedef struct {
-    GameState state;
-    PegColor secret_code[NUM_PEGS];
-    PegColor current_guess[NUM_PEGS];
-    int cursor_position;
-    int attempts_used;
-    uint32_t start_time;
-    uint32_t elapsed_time;
-    
-    // History of previous guesses and feedback
-    PegColor guess_history[MAX_ATTEMPTS][NUM_PEGS];
-    FeedbackType feedback_history[MAX_ATTEMPTS][NUM_PEGS];
-} CodeBreakerState;
+    uint32_t last_us;        // Time of the previous draw_callback
+    uint32_t worst_us;
+    uint32_t window_start;   // Tick the current redraw rate window began
+    uint32_t window_frames;
+    uint32_t rate_x10;       // Redraws per second over the last full window, times 10
+} HirnDebugStats;
+#endif
+
+// Owned by the app thread; the draw callback only reads the snapshot and
+// owns the view cache, the hint worker only touches the hint_ fields
+typedef struct {
+    CodeBreakerState state;
+    HirnCandidates candidates;  // Secrets still consistent with all feedback
+    int8_t conflict;            // Attempt the current guess contradicts, -1 if none
+    FuriMessageQueue* event_queue;
+    FuriTimer* clock_timer;  // One-shot, re-armed for each second boundary while playing
+
+    // Hint search, runs on its own thread over a copy of the candidates
+    FuriThread* hint_thread;
+    HirnCandidates hint_candidates;
+    HirnSolverControl hint_control;
+    atomic_bool hint_abandon;  // The result is no longer wanted, the worker may drop it
+    uint32_t hint_generation;  // Bumped per search so stale results are dropped
+    uint32_t hint_budget_ms;   // Budget of the running search
+    bool hint_running;
+
+    uint8_t hint_budget;  // Setting, index into hint_budgets_ms
+    HirnHint last_hint;   // Stats of the last delivered hint
+    bool has_last_hint;
+
+    InputKey long_held;      // Key whose long press was handled, its repeats are ignored till release
+    atomic_uint dropped_inputs;  // Input events the full queue turned away
+
+    bool history_open;       // Long Down toggles the list of all attempts
+    uint8_t history_scroll;  // In pixels, see hirn_history_max_scroll
+
+    HirnVariant variant;           // Variant of new rounds
+    bool settings_open;            // Down on the pause screen opens the settings
+    uint8_t settings_row;          // HirnSettingsRow
+    HirnVariant settings_variant;  // Edited there, becomes variant with OK
+
+    HirnSnapshot snapshot;    // Published after every change, see publish_render
+    HirnViewCache view;       // Only used by the draw callback
+#ifdef HIRN_PROFILE
+    atomic_uint shown_stamp;  // Stamp of the oldest input the next frame shows, 0 if none
+#endif
+
+#ifdef HIRN_DEBUG_OVERLAY
+    bool debug_overlay;
+    uint8_t press_cursor;     // Cursor before the last Right press, a long Right puts it back
+    FuriThreadId app_thread;  // Its stack is watched by the overlay
+    HirnDebugStats debug;     // Only used by the draw callback
+#endif
+} HirnApp;
+
+// What the last frame showed of the things that change without input
+typedef struct {
+    uint32_t second;   // HUD clock
+    int hint_percent;  // Progress of the running hint search, -1 if none
+    bool pending;      // Input or a state change since the last frame
+    uint32_t frames;   // Repaints requested so far
+} HirnRedraw;
+
+// Compute budgets to choose from in the pause screen
+static const uint32_t hint_budgets_ms[] = {50, 500, HIRN_SOLVER_UNLIMITED};
+#define HINT_BUDGET_COUNT (sizeof(hint_budgets_ms) / sizeof(hint_budgets_ms[0]))
+#define HINT_BUDGET_DEFAULT 1
+
+// Progress of the running hint search in percent, -1 if there is none
+static int hint_percent(HirnSolverControl* control, bool running, HirnVariant variant) {
+    if(!running) return -1;
+    uint32_t progress = atomic_load_explicit(&control->progress, memory_order_relaxed);
+    return progress * 100 / hirn_code_space(variant);
+}
+
+#ifdef HIRN_DEBUG_OVERLAY
+// Performance overlay over the board, values from the previous frame
+static void draw_debug_overlay(Canvas* canvas, const HirnApp* app) {
+    char line[32];
+    canvas_set_color(canvas, ColorWhite);
+    canvas_draw_box(canvas, 0, 11, 82, 38);
+    canvas_set_color(canvas, ColorBlack);
+    canvas_draw_frame(canvas, 0, 11, 82, 38);
+    snprintf(line, sizeof(line), "frame %lu/%lu us", (unsigned long)app->debug.last_us,
+             (unsigned long)app->debug.worst_us);
+    canvas_draw_str(canvas, 2, 19, line);
+    snprintf(line, sizeof(line), "redraw %lu.%lu/s", (unsigned long)(app->debug.rate_x10 / 10),
+             (unsigned long)(app->debug.rate_x10 % 10));
+    canvas_draw_str(canvas, 2, 28, line);
+    snprintf(line, sizeof(line), "stack %lu/%d free",
+             (unsigned long)furi_thread_get_stack_space(app->app_thread), APP_STACK_SIZE);
+    canvas_draw_str(canvas, 2, 37, line);
+    snprintf(line, sizeof(line), "heap %lu free", (unsigned long)memmgr_get_free_heap());
+    canvas_draw_str(canvas, 2, 46, line);
+}
+
+// Account for a finished draw_callback that started at start (profile units)
+static void debug_frame_done(HirnApp* app, uint32_t start) {
+    HirnDebugStats* debug = &app->debug;
+    debug->last_us = (hirn_profile_now() - start) / hirn_profile_per_us();
+    if(debug->last_us > debug->worst_us) debug->worst_us = debug->last_us;
+    debug->window_frames++;
+    uint32_t now = furi_get_tick();
+    uint32_t window = now - debug->window_start;
+    if(window >= 1000) {
+        debug->rate_x10 = debug->window_frames * 10000 / window;
+        debug->window_frames = 0;
+        debug->window_start = now;
+    }
+}
+#endif
 
 // ============================================================================
-// Game Logic Functions
+// GUI Callback Functions
 // ============================================================================
 
-// Generate random secret code
-static void generate_secret_code(CodeBreakerState* state) {
-    FURI_LOG_I(TAG, "Generating secret code (COLOR_REPEAT=%d)", COLOR_REPEAT);
-    
-    if(COLOR_REPEAT) {
-        // Colors can repeat
-        for(int i = 0; i < NUM_PEGS; i++) {
-            state->secret_code[i] = (rand() % NUM_COLORS) + 1;
-        }
-    } else {
-        // No color repetition
-        bool used[NUM_COLORS + 1] = {false};
-        for(int i = 0; i < NUM_PEGS; i++) {
-            PegColor color;
-            do {
-                color = (rand() % NUM_COLORS) + 1;
-            } while(used[color]);
-            used[color] = true;
-            state->secret_code[i] = color;
-        }
-    }
-    FURI_LOG_I(TAG, "Secret code: [%d, %d, %d, %d]", 
-               state->secret_code[0], state->secret_code[1], 
-               state->secret_code[2], state->secret_code[3]);
+// Draw callback
+static void draw_callback(Canvas* canvas, void* ctx) {
+    HIRN_PROFILE_START(profile);
+#ifdef HIRN_DEBUG_OVERLAY
+    uint32_t debug_start = hirn_profile_now();
+#endif
+    HirnApp* app = (HirnApp*)ctx;
+#ifdef HIRN_PROFILE
+    // Taken before the snapshot, which is published before the stamp
+    uint32_t shown_stamp = atomic_exchange_explicit(&app->shown_stamp, 0, memory_order_acquire);
+#endif
+    // A consistent copy, the app thread may change its state meanwhile
+    HirnRenderState render;
+    hirn_snapshot_read(&app->snapshot, &render);
+    hirn_view_draw(canvas, &render, &app->view);
+
+#ifdef HIRN_DEBUG_OVERLAY
+    if(render.debug_overlay) draw_debug_overlay(canvas, app);
+    debug_frame_done(app, debug_start);
+#endif
+    HIRN_PROFILE_STOP(HirnProfileDrawCallback, profile);
+#ifdef HIRN_PROFILE
+    if(shown_stamp) hirn_profile_record(HirnProfileInputToDisplay, hirn_profile_now() - shown_stamp);
+#endif
 }
 
-// Check if all pegs in current guess have been selected
-static bool is_guess_complete(CodeBreakerState* state) {
-    for(int i = 0; i < NUM_PEGS; i++) {
-        if(state->current_guess[i] == COLOR_NONE) {
-            return false;
-        }
+// Input callback, runs on the input thread which must not wait for us
+static void input_callback(InputEvent* input_event, void* ctx) {
+    HirnApp* app = (HirnApp*)ctx;
+    HirnEvent event = {.type = EventTypeInput, .input = *input_event};
+#ifdef HIRN_PROFILE
+    event.stamp = hirn_profile_now();
+#endif
+    if(furi_message_queue_put(app->event_queue, &event, 0) != FuriStatusOk) {
+        atomic_fetch_add_explicit(&app->dropped_inputs, 1, memory_order_relaxed);
     }
-    return true;
 }
 
-static void reset_game_state(CodeBreakerState* state) {
-    state->state = STATE_PLAYING;
-    state->cursor_position = 0;
-    state->attempts_used = 0;
-    state->start_time = furi_get_tick();
-    state->elapsed_time = 0;
-    
-    for(int i = 0; i < NUM_PEGS; i++) {
-        state->current_guess[i] = COLOR_NONE;
-    }
-    
-    generate_secret_code(state);
+// Clock timer callback, runs on the timer thread
+static void clock_callback(void* ctx) {
+    HirnApp* app = (HirnApp*)ctx;
+    HirnEvent event = {.type = EventTypeClock};
+    // On a full queue the tick is lost, see update_clock
+    furi_message_queue_put(app->event_queue, &event, 0);
 }
 
-// Check if current guess is different from previous guess
-static bool is_guess_different(CodeBreakerState* state) {
-    if(state->attempts_used == 0) {
-        return true;  // First guess is always different
-    }
-    
-    for(int i = 0; i < NUM_PEGS; i++) {
-        if(state->current_guess[i] != state->guess_history[state->attempts_used - 1][i]) {
-            return true;
-        }
+// ============================================================================
+// Hint Worker
+// ============================================================================
+
+static int32_t hint_worker(void* ctx) {
+    HirnApp* app = (HirnApp*)ctx;
+    HirnEvent event = {.type = EventTypeHint, .hint = {.generation = app->hint_generation}};
+    event.hint.found =
+        hirn_solver_search(&app->hint_candidates, &app->hint_control, app->hint_budget_ms, &event.hint.hint);
+    // Don't block forever: after stop_hint the app thread may be joining us.
+    // A taken hint is always delivered, the app thread goes on reading the queue.
+    while(furi_message_queue_put(app->event_queue, &event, 10) != FuriStatusOk) {
+        if(atomic_load(&app->hint_abandon)) break;
     }
-    return false;
+    return 0;
 }
 
-// Evaluate the current guess and provide feedback
-static void evaluate_guess(CodeBreakerState* state) {
-    FURI_LOG_I(TAG, "Evaluating guess #%d: [%d, %d, %d, %d]", 
-               state->attempts_used + 1,
-               state->current_guess[0], state->current_guess[1],
-               state->current_guess[2], state->current_guess[3]);
-    
-    bool secret_used[NUM_PEGS] = {false};
-    bool guess_used[NUM_PEGS] = {false};
-    int feedback_idx = 0;
-    
-    // Initialize feedback to none
-    for(int i = 0; i < NUM_PEGS; i++) {
-        state->feedback_history[state->attempts_used][i] = FEEDBACK_NONE;
+// Search the best next guess in the background, delivered as EventTypeHint
+static void start_hint(HirnApp* app) {
+    if(app->hint_running || app->state.state != STATE_PLAYING) return;
+
+    // The first two turns come from the opening book, no search needed
+    uint16_t book_guess;
+    if(hirn_book_lookup(&app->state, &book_guess)) {
+        FURI_LOG_I(TAG, "Hint from opening book: code index %d", book_guess);
+        memset(&app->last_hint, 0, sizeof(HirnHint));
+        app->last_hint.guess = book_guess;
+        app->last_hint.complete = true;
+        app->has_last_hint = true;
+        set_current_guess(&app->state, hirn_code_from_index(book_guess, app->state.variant));
+        return;
     }
-    
-    // First pass: check for exact matches (black pegs)
-    for(int i = 0; i < NUM_PEGS; i++) {
-        if(state->current_guess[i] == state->secret_code[i]) {
-            state->feedback_history[state->attempts_used][feedback_idx++] = FEEDBACK_BLACK;
-            secret_used[i] = true;
-            guess_used[i] = true;
-        }
+
+    app->hint_budget_ms = hint_budgets_ms[app->hint_budget];
+    FURI_LOG_I(TAG, "Hint search started over %d candidates, budget %lu ms",
+               (int)app->candidates.count, app->hint_budget_ms);
+    hirn_candidates_copy(&app->hint_candidates, &app->candidates);
+    atomic_store(&app->hint_control.stop, false);
+    atomic_store(&app->hint_abandon, false);
+    atomic_store(&app->hint_control.progress, 0);
+    app->hint_generation++;
+    app->hint_running = true;
+    furi_thread_start(app->hint_thread);
+}
+
+// Stop a running search early, its best guess so far is still delivered
+static void take_hint(HirnApp* app) {
+    if(!app->hint_running) return;
+    FURI_LOG_I(TAG, "Hint taken early");
+    atomic_store(&app->hint_control.stop, true);
+}
+
+// Cancel a running search, drop its result and wait for the worker to finish
+static void stop_hint(HirnApp* app) {
+    if(!app->hint_running) return;
+    FURI_LOG_I(TAG, "Hint search cancelled");
+    atomic_store(&app->hint_abandon, true);
+    atomic_store(&app->hint_control.stop, true);
+    furi_thread_join(app->hint_thread);
+    app->hint_running = false;
+}
+
+// Put the suggested guess into the guess area
+static void apply_hint(HirnApp* app, const HirnHintResult* result) {
+    if(!app->hint_running || result->generation != app->hint_generation) return;  // Cancelled search
+    furi_thread_join(app->hint_thread);
+    app->hint_running = false;
+    if(!result->found) return;
+    const HirnHint* hint = &result->hint;
+    app->last_hint = *hint;
+    app->has_last_hint = true;
+    FURI_LOG_I(TAG, "Hint: code index %d, worst case %d, %lu guesses in %lu ms%s",
+               hint->guess, hint->worst, hint->evaluated, hint->duration_ms,
+               hint->complete ? "" : " (stopped early)");
+    if(app->state.state == STATE_PLAYING) {
+        set_current_guess(&app->state, hirn_code_from_index(hint->guess, app->state.variant));
     }
-    
-    // Second pass: check for color matches in wrong position (white pegs)
-    for(int i = 0; i < NUM_PEGS; i++) {
-        if(!guess_used[i]) {
-            for(int j = 0; j < NUM_PEGS; j++) {
-                if(!secret_used[j] && state->current_guess[i] == state->secret_code[j]) {
-                    state->feedback_history[state->attempts_used][feedback_idx++] = FEEDBACK_WHITE;
-                    secret_used[j] = true;
-                    break;
-                }
-            }
-        }
+}
+
+// Step through hint_budgets_ms
+static void cycle_hint_budget(HirnApp* app, int delta) {
+    int shift = delta % (int)HINT_BUDGET_COUNT;
+    app->hint_budget = (app->hint_budget + HINT_BUDGET_COUNT + shift) % HINT_BUDGET_COUNT;
+    FURI_LOG_D(TAG, "Hint budget: %lu ms", hint_budgets_ms[app->hint_budget]);
+}
+
+// ============================================================================
+// Game Flow
+// ============================================================================
+
+// Start a new round of app->variant with a fresh secret and a full candidate set
+static void start_round(HirnApp* app) {
+    stop_hint(app);
+    reset_game_state(&app->state, app->variant);
+    hirn_candidates_reset(&app->candidates, app->variant);
+}
+
+// Score the current guess and narrow the candidates down with its feedback
+static void submit_guess(HirnApp* app) {
+    CodeBreakerState* state = &app->state;
+    stop_hint(app);
+    evaluate_guess(state);
+    int last = state->attempts_used - 1;
+    hirn_candidates_filter(&app->candidates, hirn_code_from_index(state->guess_history[last], state->variant),
+                           state->feedback_history[last]);
+    FURI_LOG_D(TAG, "Candidates left: %d", (int)app->candidates.count);
+}
+
+// Show the list of all attempts, newest on top
+static void open_history(HirnApp* app) {
+    app->history_open = true;
+    app->history_scroll = 0;
+}
+
+// Scroll the history by steps (negative up): a press moves to the next row
+// boundary, held repeats glide a few pixels per step
+static void scroll_history(HirnApp* app, int steps, bool whole_row) {
+    int scroll = app->history_scroll;
+    if(whole_row) {
+        int row = steps > 0 ? scroll / HIRN_HISTORY_ROW_HEIGHT + 1 :
+                                  (scroll + HIRN_HISTORY_ROW_HEIGHT - 1) / HIRN_HISTORY_ROW_HEIGHT - 1;
+        scroll = row * HIRN_HISTORY_ROW_HEIGHT;
+    } else {
+        scroll += steps * HISTORY_GLIDE_PX;
     }
-    
-    FURI_LOG_D(TAG, "Feedback: Black=%d, White=%d", 
-               feedback_idx > 0 && state->feedback_history[state->attempts_used][0] == FEEDBACK_BLACK ? 1 : 0,
-               feedback_idx);
-    
-    // Check for win condition (all black pegs)
-    bool won = true;
-    for(int i = 0; i < NUM_PEGS; i++) {
-        if(state->current_guess[i] != state->secret_code[i]) {
-            won = false;
-            break;
+    int max_scroll = hirn_history_max_scroll(app->state.attempts_used);
+    if(scroll < 0) scroll = 0;
+    if(scroll > max_scroll) scroll = max_scroll;
+    app->history_scroll = scroll;
+}
+
+// Show the settings of the pause screen, starting from the current variant
+static void open_settings(HirnApp* app) {
+    app->settings_open = true;
+    app->settings_row = HirnSettingsRowHint;
+    app->settings_variant = app->variant;
+}
+
+// One step of a variant setting in direction (+1/-1), past the values that
+// don't make a valid variant with the others. Stays put if there is none.
+static HirnVariant step_variant(HirnVariant variant, int row, int direction) {
+    HirnVariant next = variant;
+    for(;;) {
+        if(row == HirnSettingsRowPegs) {
+            next.pegs += direction;
+            if(next.pegs < HIRN_MIN_PEGS || next.pegs > HIRN_MAX_PEGS) return variant;
+        } else if(row == HirnSettingsRowColors) {
+            next.colors += direction;
+            if(next.colors < HIRN_MIN_COLORS || next.colors > HIRN_MAX_COLORS) return variant;
+        } else {
+            next.repeat = !next.repeat;
+            return hirn_variant_valid(next) ? next : variant;
         }
+        if(hirn_variant_valid(next)) return next;
     }
-    
-    // Save guess to history
-    for(int i = 0; i < NUM_PEGS; i++) {
-        state->guess_history[state->attempts_used][i] = state->current_guess[i];
+}
+
+// Left/Right on the selected settings row, steps times
+static void change_setting(HirnApp* app, int direction, int steps) {
+    if(app->settings_row == HirnSettingsRowHint) {
+        cycle_hint_budget(app, direction * steps);
+        return;
     }
-    
-    state->attempts_used++;
-    
-    if(won) {
-        state->state = STATE_WON;
-        state->elapsed_time += furi_get_tick() - state->start_time;
-        FURI_LOG_I(TAG, "Game won! Attempts: %d, Time: %lu ms", 
-                   state->attempts_used, state->elapsed_time);
-    } else if(state->attempts_used >= MAX_ATTEMPTS) {
-        state->state = STATE_LOST;
-        state->elapsed_time += furi_get_tick() - state->start_time;
-        FURI_LOG_I(TAG, "Game lost! Max attempts reached.");
+    for(int i = 0; i < steps; i++) {
+        app->settings_variant = step_variant(app->settings_variant, app->settings_row, direction);
     }
-    // Don't reset guess - keep previous colors for next attempt
 }
 
-// ============================================================================
-// Drawing Functions
-// ============================================================================
+// OK on the settings: a changed variant starts a new round right away
+static void apply_settings(HirnApp* app) {
+    app->settings_open = false;
+    HirnVariant variant = app->settings_variant;
+    if(hirn_variant_equal(variant, app->variant)) return;
+    FURI_LOG_I(TAG, "Variant set to %d pegs, %d colors, repeat %d", variant.pegs, variant.colors, variant.repeat);
+    app->variant = variant;
+    start_round(app);
+}
 
-// Draw modal dialog box with text
-static void draw_simple_modal(Canvas* canvas, const char* text) {
-	canvas_set_font(canvas, FontPrimary);
-    const int box_w = canvas_string_width(canvas, text) + 6;
-    const int box_h = 20;
-    const int box_x = 2;
-    const int box_y = 20;
-    // White filled rectangle
-    canvas_set_color(canvas, ColorWhite);
-    canvas_draw_box(canvas, box_x, box_y, box_w, box_h);
-    // Black border
-    canvas_set_color(canvas, ColorBlack);
-    canvas_draw_frame(canvas, box_x, box_y, box_w, box_h);
-    // Text inside
-    canvas_draw_str(canvas, box_x + 2, box_y + 14, text);
-	canvas_set_font(canvas, FontSecondary);
+// Recheck the current guess against the history, at most one scoring per attempt
+static void update_conflict(HirnApp* app) {
+    int conflict = find_conflicting_attempt(&app->state);
+    if(conflict != app->conflict) {
+        if(conflict >= 0) FURI_LOG_D(TAG, "Guess conflicts with attempt %d", conflict + 1);
+        app->conflict = conflict;
+    }
 }
 
-// Draw a filled circle with pattern
-static void draw_peg(Canvas* canvas, int x, int y, int radius, PegColor color) {
-    switch(color) {
-    case COLOR_NONE:
-        // Empty circle
-        canvas_draw_circle(canvas, x, y, radius);
-        break;
-    case COLOR_RED:
-        // Solid fill
-        canvas_draw_disc(canvas, x, y, radius);
-        break;
-    case COLOR_GREEN:
-        // Horizontal lines
-        canvas_draw_circle(canvas, x, y, radius);
-        for(int i = -radius; i <= radius; i += 3) {
-            if(y + i >= 0) {
-                int half_width = (int)sqrt(radius * radius - i * i);
-                canvas_draw_line(canvas, x - half_width, y + i, x + half_width, y + i);
-            }
+// Keep the clock timer armed for the next second boundary of the play time
+// while playing. MAX_TIME_MS is whole seconds, so the limit hits on a tick.
+static void update_clock(HirnApp* app, bool ticked) {
+    bool playing = app->state.state == STATE_PLAYING;
+    // Ask the timer rather than remember arming it: a tick the full queue
+    // dropped leaves it stopped without an event
+    bool armed = furi_timer_is_running(app->clock_timer);
+    if(playing && (ticked || !armed)) {
+        uint32_t ms = 1000 - get_total_time(&app->state) % 1000;
+        furi_timer_start(app->clock_timer, furi_ms_to_ticks(ms));
+    } else if(!playing && armed) {
+        furi_timer_stop(app->clock_timer);
+    }
+}
+
+// Act on one input event. steps > 1 for repeats of a held key folded into
+// one event, stepping that many times. Returns false to exit the app.
+static bool handle_input(HirnApp* app, const InputEvent* input, int steps) {
+    CodeBreakerState* state = &app->state;
+    bool running = true;
+    // A new press ends any hold whose release got dropped
+    if(input->type == InputTypePress && input->key == app->long_held) app->long_held = InputKeyMAX;
+
+    if(input->type == InputTypeRelease && input->key == app->long_held) {
+        app->long_held = InputKeyMAX;
+    } else if(app->settings_open && (input->type == InputTypePress || input->type == InputTypeRepeat)) {
+        // Up/Down pick a row, Left/Right change it, OK applies and Back discards
+        if(input->key == InputKeyBack && input->type == InputTypePress) {
+            app->settings_open = false;
+        } else if(input->key == InputKeyOk && input->type == InputTypePress) {
+            apply_settings(app);
+        } else if(input->key == InputKeyUp || input->key == InputKeyDown) {
+            int row = app->settings_row + (input->key == InputKeyDown ? steps : -steps);
+            if(row < 0) row = 0;
+            if(row > HirnSettingsRowCount - 1) row = HirnSettingsRowCount - 1;
+            app->settings_row = row;
+        } else if(input->key == InputKeyLeft || input->key == InputKeyRight) {
+            change_setting(app, input->key == InputKeyRight ? 1 : -1, steps);
         }
-        break;
-    case COLOR_BLUE:
-        // Vertical lines
-        canvas_draw_circle(canvas, x, y, radius);
-        for(int i = -radius; i <= radius; i += 3) {
-            if(x + i >= 0) {
-                int half_height = (int)sqrt(radius * radius - i * i);
-                canvas_draw_line(canvas, x + i, y - half_height, x + i, y + half_height);
-            }
+    } else if(app->history_open && (input->type == InputTypePress || input->type == InputTypeRepeat)) {
+        // The history only scrolls, Back returns to the board
+        if(input->key == InputKeyBack && input->type == InputTypePress) {
+            app->history_open = false;
+        } else if((input->key == InputKeyUp || input->key == InputKeyDown) && input->key != app->long_held) {
+            scroll_history(app, input->key == InputKeyDown ? steps : -steps, input->type == InputTypePress);
         }
-        break;
-    case COLOR_YELLOW:
-        // Diagonal lines (/)
-        canvas_draw_circle(canvas, x, y, radius);
-        for(int offset = -radius * 2; offset <= radius * 2; offset += 4) {
-            for(int i = -radius; i <= radius; i++) {
-                int j = i + offset;
-                if(i * i + j * j <= radius * radius) {
-                    if(x + i >= 0 && y - j >= 0) {
-                        canvas_draw_dot(canvas, x + i, y - j);
-                    }
+    } else if(input->type == InputTypePress || input->type == InputTypeRepeat) {
+        if(input->key == InputKeyBack) {
+            if(input->type == InputTypePress) {
+                // Short press - pause (when playing) or exit (when paused)
+                if(state->state == STATE_PAUSED) {
+                    // Exit when paused
+                    FURI_LOG_I(TAG, "User exiting from pause menu");
+                    running = false;
+                } else {
+                    pause_game(state);
                 }
             }
-        }
-        break;
-    case COLOR_PURPLE:
-        // Diagonal lines (\)
-        canvas_draw_circle(canvas, x, y, radius);
-        for(int offset = -radius * 2; offset <= radius * 2; offset += 4) {
-            for(int i = -radius; i <= radius; i++) {
-                int j = -i + offset;
-                if(i * i + j * j <= radius * radius) {
-                    if(x + i >= 0 && y - j >= 0) {
-                        canvas_draw_dot(canvas, x + i, y - j);
-                    }
-                }
+        } else if(input->key == InputKeyLeft && state->state == STATE_PLAYING) {
+            move_cursor(state, -steps);
+        } else if(input->key == InputKeyRight && state->state == STATE_PLAYING) {
+#ifdef HIRN_DEBUG_OVERLAY
+            if(input->type == InputTypePress) app->press_cursor = state->cursor_position;
+#endif
+            if(input->key != app->long_held) move_cursor(state, steps);
+        } else if((input->key == InputKeyLeft || input->key == InputKeyRight) && state->state == STATE_PAUSED) {
+            if(input->key != app->long_held) cycle_hint_budget(app, input->key == InputKeyRight ? steps : -steps);
+        } else if(input->key == InputKeyDown && state->state == STATE_PAUSED && input->type == InputTypePress) {
+            open_settings(app);
+        } else if(input->key == InputKeyUp && state->state == STATE_PLAYING) {
+            if(input->key != app->long_held) cycle_color(state, steps);
+        } else if(input->key == InputKeyDown && state->state == STATE_PLAYING) {
+            if(input->key != app->long_held) cycle_color(state, -steps);
+        } else if(input->key == InputKeyOk) {
+            if(state->state == STATE_PLAYING && is_guess_complete(state) && is_guess_different(state)) {
+                FURI_LOG_I(TAG, "Submitting guess");
+                submit_guess(app);
+            } else if(state->state == STATE_PAUSED || state->state == STATE_REVEAL) {
+                resume_game(state);
+            } else if(state->state == STATE_WON || state->state == STATE_LOST) {
+                // Reset game
+                FURI_LOG_I(TAG, "Resetting game for new round");
+                start_round(app);
             }
         }
-        break;
-    case COLOR_ORANGE:
-        // Cross-hatch
-        canvas_draw_circle(canvas, x, y, radius);
-        for(int i = -radius; i <= radius; i += 3) {
-            if(y + i >= 0) {
-                int half_width = (int)sqrt(radius * radius - i * i);
-                canvas_draw_line(canvas, x - half_width, y + i, x + half_width, y + i);
+    } else if(input->type == InputTypeLong) {
+        if(input->key == InputKeyBack) {
+            // Long press - exit
+            FURI_LOG_I(TAG, "User exiting via long press");
+            running = false;
+        } else if(input->key == InputKeyDown && !app->history_open) {
+            // Long press - show all attempts, not while the pause hides the board.
+            // Otherwise the hold goes on stepping the color.
+            if(state->attempts_used > 0 && state->state != STATE_PAUSED) {
+                app->long_held = InputKeyDown;
+                // The press before stepped the color, undo that
+                if(state->state == STATE_PLAYING) cycle_color(state, 1);
+                open_history(app);
             }
-            if(x + i >= 0) {
-                int half_height = (int)sqrt(radius * radius - i * i);
-                canvas_draw_line(canvas, x + i, y - half_height, x + i, y + half_height);
+        } else if(app->history_open) {
+            // Nothing else acts on the hidden board
+        } else if(input->key == InputKeyOk) {
+            // Long press - reveal combination
+            toggle_reveal(state);
+        } else if(input->key == InputKeyUp) {
+            // Long press - suggest the next guess, or take the running search's best so far
+            app->long_held = InputKeyUp;
+            if(app->hint_running) {
+                take_hint(app);
+            } else {
+                start_hint(app);
+            }
+        }
+#ifdef HIRN_DEBUG_OVERLAY
+        else if(input->key == InputKeyRight && !app->settings_open) {
+            // Long press - toggle the performance overlay, the hold moves nothing
+            app->long_held = InputKeyRight;
+            // The press before moved the cursor or changed the budget, undo that
+            if(state->state == STATE_PLAYING) {
+                state->cursor_position = app->press_cursor;
+            } else if(state->state == STATE_PAUSED) {
+                cycle_hint_budget(app, -1);
             }
+            app->debug_overlay = !app->debug_overlay;
         }
-        break;
+#endif
     }
+    return running;
 }
 
-// Draw feedback pegs (2x2 arrangement)
-static void draw_feedback(Canvas* canvas, int x, int y, FeedbackType feedback[NUM_PEGS], int radius) {
-    int spacing = radius * 2 + 2;  // Space between feedback pegs
-    int positions[4][2] = {{0, 0}, {spacing, 0}, {0, spacing}, {spacing, spacing}};
-    
-    for(int i = 0; i < NUM_PEGS; i++) {
-        int px = x + positions[i][0];
-        int py = y + positions[i][1];
-        canvas_draw_circle(canvas, px, py, radius); // draw circle outline
-        if(feedback[i] == FEEDBACK_BLACK) {
-            canvas_draw_disc(canvas, px, py, radius);
-        } else if(feedback[i] == FEEDBACK_WHITE) { // grey dot pattern fill
-            for(int dy = -radius; dy <= radius; dy += 2) {
-                for(int dx = -radius; dx <= radius; dx += 2) {
-                    if(dx * dx + dy * dy <= radius * radius) {
-                        canvas_draw_dot(canvas, px + dx, py + dy);
-                    }
-                }
-            }
-        }
+// Repeats of a held key right after events[*i] fold into it, e.g. three
+// cursor moves for one repaint. Returns the steps and leaves *i on the last
+// event folded in. Keys whose long press was handled drop their repeats in
+// handle_input, folded or not: a held Up after its hint, a held Down after
+// it opened the history, a held Right after it toggled the overlay.
+static int fold_repeats(const HirnEvent* events, size_t count, size_t* i) {
+    const InputEvent* input = &events[*i].input;
+    int steps = 1;
+    while(input->type == InputTypeRepeat && *i + 1 < count && events[*i + 1].type == EventTypeInput &&
+          events[*i + 1].input.type == InputTypeRepeat && events[*i + 1].input.key == input->key) {
+        steps++;
+        (*i)++;
     }
+    return steps;
 }
 
 // ============================================================================
-// GUI Callback Functions
+// Redraw Scheduling
 // ============================================================================
 
-// Draw callback
-static void draw_callback(Canvas* canvas, void* ctx) {
-    CodeBreakerState* state = (CodeBreakerState*)ctx;
-    canvas_clear(canvas);
-    canvas_set_font(canvas, FontSecondary);
-    
-	// Draw header with icon and title
-    canvas_set_font(canvas, FontPrimary);
-	canvas_draw_icon(canvas, 1, 1, &I_icon_10x10);	
-	canvas_draw_str_aligned(canvas, 13, 1, AlignLeft, AlignTop, "HIRN");
-	canvas_set_font(canvas, FontSecondary);
-	
-    // Draw HUD (top right)
-    char time_str[16];
-    uint32_t total_time;
-    if(state->state == STATE_PLAYING) {
-        total_time = state->elapsed_time + (furi_get_tick() - state->start_time);
-    } else {
-        total_time = state->elapsed_time;
-    }
-	if(total_time > MAX_TIME_MS) total_time = MAX_TIME_MS;
-    uint32_t seconds = total_time / 1000;
-    uint32_t minutes = seconds / 60;
-    seconds = seconds % 60;
-    snprintf(time_str, sizeof(time_str), "A: %d(%d) %02lu:%02lu", state->attempts_used, MAX_ATTEMPTS, minutes, seconds);
-    canvas_draw_str(canvas, HUD_X_POSITION, 7, time_str);
-	canvas_draw_str_aligned(canvas, 127, 8, AlignRight, AlignTop, "f418.eu"); 
-    canvas_draw_str_aligned(canvas, 127, 16, AlignRight, AlignTop, "v0.2"); 	
-    
-    // Draw current guess area
-    int peg_radius = CURSOR_SIZE / 2 - 2;  // Peg radius is slightly smaller than half cursor
-    int peg_spacing = CURSOR_SIZE;         // Pegs touch when cursors would touch
-    int feedback_radius = (CURSOR_SIZE / 8 > 2) ? CURSOR_SIZE / 8 : 3; // Feedback pegs scale with cursor, min 3
-    int guess_y = PEG_Y_POSITION;   // Vertical position
-
-    for(int i = 0; i < NUM_PEGS; i++) {
-        int x = PEG_X_POSITION + i * peg_spacing;
-        
-        // Draw cursor rectangle
-        if(i == state->cursor_position && state->state == STATE_PLAYING) {
-            canvas_draw_rframe(canvas, x - CURSOR_SIZE/2, guess_y - CURSOR_SIZE/2, CURSOR_SIZE + 1, CURSOR_SIZE + 1, 2);
-        }
-        
-        draw_peg(canvas, x, guess_y, peg_radius, state->current_guess[i]);
-    }
-        
-	// Draw last guess from history (directly below current guess)
-	if(state->attempts_used > 0) {
-		int history_y = guess_y + peg_spacing;  // Below current guess with spacing
-		for(int i = 0; i < NUM_PEGS; i++) {
-			int x = PEG_X_POSITION + i * peg_spacing;
-			draw_peg(canvas, x, history_y, peg_radius - 2, state->guess_history[state->attempts_used - 1][i]);
-		}
-    draw_feedback(canvas, PEG_X_POSITION + NUM_PEGS * peg_spacing + 5, history_y - 5, state->feedback_history[state->attempts_used - 1], feedback_radius);
-}
-	
-	
-    // Construct status message
-	const char* modal_text = NULL;
-    if(state->state == STATE_PAUSED) {
-        modal_text = "Paused.";
-    } else if(state->state == STATE_WON) {
-        modal_text = "You won!";
-    } else if(state->state == STATE_LOST) {
-        if(total_time >= MAX_TIME_MS) {
-            modal_text = "Time out :-(";
-        } else {
-            modal_text = "No attempts left :-(";
-        }
-    }
-    
-    // Draw secret code if revealed or game ended
-    if(state->state == STATE_REVEAL || state->state == STATE_WON || state->state == STATE_LOST) {
-        canvas_set_font(canvas, FontSecondary);
-        canvas_draw_str(canvas, 10, 120, "Code:");
-        for(int i = 0; i < NUM_PEGS; i++) {
-            draw_peg(canvas, 45 + i * 20, 120, 8, state->secret_code[i]);
-        }
-    }
-	
-    if(modal_text) {
-		draw_simple_modal(canvas, modal_text);
-		// When modal is shown, only show exit hint
-	    canvas_draw_icon(canvas, 121, 57, &I_back);
-	    canvas_draw_str_aligned(canvas, 120, 63, AlignRight, AlignBottom, "Exit");	
-   	} else {
-	    // Normal hints
-	    canvas_draw_icon(canvas, 1, 55, &I_arrows);
-	    canvas_draw_str_aligned(canvas, 11, 62, AlignLeft, AlignBottom, "Navigate");
-	    canvas_draw_icon(canvas, 121, 57, &I_back);
-	    canvas_draw_str_aligned(canvas, 120, 63, AlignRight, AlignBottom, "Pause");
-	}
-
-    if(state->state == STATE_PLAYING && is_guess_complete(state) && is_guess_different(state)) {
-        elements_button_center(canvas, "OK");
-    } else if(state->state == STATE_PAUSED) {
-        elements_button_center(canvas, "Resume");
-    } else if(state->state == STATE_WON || state->state == STATE_LOST) {
-        elements_button_center(canvas, "Play again");
-    }
+// Hand the current state to the draw callback
+static void publish_render(HirnApp* app) {
+    HirnRenderState render = {
+        .state = app->state,
+        .candidates = app->candidates.count,
+        .conflict = app->conflict,
+        .hint_budget_ms = hint_budgets_ms[app->hint_budget],
+        .hint_percent = hint_percent(&app->hint_control, app->hint_running, app->state.variant),
+        .hint_running = app->hint_running,
+        .has_last_hint = app->has_last_hint,
+        .last_hint = app->last_hint,
+        .history_open = app->history_open,
+        .history_scroll = app->history_scroll,
+        .settings_open = app->settings_open,
+        .settings_row = app->settings_row,
+        .settings_variant = app->settings_variant,
+#ifdef HIRN_DEBUG_OVERLAY
+        .debug_overlay = app->debug_overlay,
+#endif
+    };
+    hirn_snapshot_publish(&app->snapshot, &render);
 }
 
-// Input callback
-static void input_callback(InputEvent* input_event, void* ctx) {
-    FuriMessageQueue* event_queue = (FuriMessageQueue*)ctx;
-    furi_message_queue_put(event_queue, input_event, FuriWaitForever);
+// True if the screen needs a repaint: something changed, the clock ticked
+// over to the next second, or a hint search made progress
+static bool redraw_due(HirnApp* app, HirnRedraw* redraw) {
+    uint32_t second = get_total_time(&app->state) / 1000;
+    int percent = hint_percent(&app->hint_control, app->hint_running, app->state.variant);
+    if(!redraw->pending && second == redraw->second && percent == redraw->hint_percent) return false;
+    redraw->second = second;
+    redraw->hint_percent = percent;
+    redraw->pending = false;
+    redraw->frames++;
+    return true;
 }
 
-
-
-
 // ============================================================================
 // Main Application Entry Point
 // ============================================================================
@@ -452,131 +595,116 @@ static void input_callback(InputEvent* input_event, void* ctx) {
 int32_t hirn_main(void* p) {
     UNUSED(p);    
     FURI_LOG_I(TAG, "Starting HIRN game");
-    srand(furi_get_tick());
-    FURI_LOG_D(TAG, "Random seed initialized with tick: %lu", furi_get_tick()); 
-        CodeBreakerState* state = malloc(sizeof(CodeBreakerState));
-    memset(state, 0, sizeof(CodeBreakerState));
-    FURI_LOG_D(TAG, "State allocated and initialized"); // --------------------
-    reset_game_state(state);
-
-    FuriMessageQueue* event_queue = furi_message_queue_alloc(8, sizeof(InputEvent));
+    // Seed from the hardware RNG, not the tick which is nearly the same at every start
+    uint64_t seed = ((uint64_t)furi_hal_random_get() << 32) | furi_hal_random_get();
+    seed_game_random(seed);
+    FURI_LOG_D(TAG, "Random seed initialized: %08lX%08lX", (uint32_t)(seed >> 32), (uint32_t)seed);
+    HirnApp* app = malloc(sizeof(HirnApp));
+    memset(app, 0, sizeof(HirnApp));
+    app->hint_budget = HINT_BUDGET_DEFAULT;
+    app->long_held = InputKeyMAX;
+    app->variant = HIRN_VARIANT_CLASSIC;
+    CodeBreakerState* state = &app->state;
+#ifdef HIRN_DEBUG_OVERLAY
+    app->app_thread = furi_thread_get_current_id();
+#endif
+    FURI_LOG_D(TAG, "State allocated and initialized (%d bytes, app %d bytes)",
+               (int)sizeof(CodeBreakerState), (int)sizeof(HirnApp)); // ----
+    start_round(app);
+    app->conflict = -1;
+    publish_render(app);
+
+    FuriMessageQueue* event_queue = furi_message_queue_alloc(EVENT_QUEUE_SIZE, sizeof(HirnEvent));
+    app->event_queue = event_queue;
     FURI_LOG_D(TAG, "Event queue created");
+    app->hint_thread = furi_thread_alloc_ex("HirnHint", HINT_STACK_SIZE, hint_worker, app);
+    app->clock_timer = furi_timer_alloc(clock_callback, FuriTimerTypeOnce, app);
     
     // Setup GUI
     Gui* gui = furi_record_open(RECORD_GUI);
     ViewPort* view_port = view_port_alloc();
-    view_port_draw_callback_set(view_port, draw_callback, state);
-    view_port_input_callback_set(view_port, input_callback, event_queue);
+    view_port_draw_callback_set(view_port, draw_callback, app);
+    view_port_input_callback_set(view_port, input_callback, app);
     gui_add_view_port(gui, view_port, GuiLayerFullscreen);
     FURI_LOG_I(TAG, "GUI initialized and view port added");
     
     // Main loop
-    InputEvent event;
+    HirnEvent events[EVENT_QUEUE_SIZE];
+    HirnRedraw redraw = {.hint_percent = -1, .pending = true};
     bool running = true;
+#ifdef HIRN_PROFILE
+    uint32_t pending_stamp = 0;  // Oldest input applied but not published yet, 0 if none
+#endif
     
     FURI_LOG_I(TAG, "Entering main game loop");
     
     while(running) {
-        if(furi_message_queue_get(event_queue, &event, 100) == FuriStatusOk) {
-            if(event.type == InputTypePress || event.type == InputTypeRepeat) {
-                if(event.key == InputKeyBack) {
-                    if(event.type == InputTypePress) {
-						// Short press - pause (when playing) or exit (when paused)
-						if(state->state == STATE_PAUSED) {
-							// Exit when paused
-                            FURI_LOG_I(TAG, "User exiting from pause menu");
-							running = false;
-						} else if(state->state == STATE_PLAYING) {
-							// Pause when playing
-                            FURI_LOG_I(TAG, "Game paused");
-							state->state = STATE_PAUSED;
-							state->elapsed_time += furi_get_tick() - state->start_time;
-						}
-                    }
-                } else if(event.key == InputKeyLeft && state->state == STATE_PLAYING) {
-                    if(state->cursor_position > 0) {
-                        state->cursor_position--;
-                        FURI_LOG_D(TAG, "Cursor moved left to position %d", state->cursor_position);
-                    }
-                } else if(event.key == InputKeyRight && state->state == STATE_PLAYING) {
-                    if(state->cursor_position < NUM_PEGS - 1) {
-                        state->cursor_position++;
-                        FURI_LOG_D(TAG, "Cursor moved right to position %d", state->cursor_position);
-                    }
-                } else if(event.key == InputKeyUp && state->state == STATE_PLAYING) {
-                    int current = state->current_guess[state->cursor_position];
-                    current++;
-                    if(current > NUM_COLORS) current = COLOR_NONE;
-                    state->current_guess[state->cursor_position] = current;
-                    FURI_LOG_D(TAG, "Color changed to %d at position %d", current, state->cursor_position);
-                } else if(event.key == InputKeyDown && state->state == STATE_PLAYING) {
-                    int current = state->current_guess[state->cursor_position];
-                    current--;
-                    if(current < COLOR_NONE) current = NUM_COLORS;
-                    state->current_guess[state->cursor_position] = current;
-                    FURI_LOG_D(TAG, "Color changed to %d at position %d", current, state->cursor_position);
-                } else if(event.key == InputKeyOk) {
-                    if(state->state == STATE_PLAYING && is_guess_complete(state) && is_guess_different(state)) {
-                        FURI_LOG_I(TAG, "Submitting guess");
-                        evaluate_guess(state);
-                    } else if(state->state == STATE_PAUSED) {
-                        FURI_LOG_I(TAG, "Game resumed");
-                        state->state = STATE_PLAYING;
-                        state->start_time = furi_get_tick();
-                    } else if(state->state == STATE_REVEAL) {
-                        FURI_LOG_I(TAG, "Returning to game from reveal");
-                        state->state = STATE_PLAYING;
-                        state->start_time = furi_get_tick();
-                    } else if(state->state == STATE_WON || state->state == STATE_LOST) {
-						// Reset game
-						FURI_LOG_I(TAG, "Resetting game for new round");
-						reset_game_state(state);
-					}
-                }
-            } else if(event.type == InputTypeLong) {
-                if(event.key == InputKeyBack) {
-                    // Long press - exit
-                    FURI_LOG_I(TAG, "User exiting via long press");
-                    running = false;
-                } else if(event.key == InputKeyOk) {
-                    // Long press - reveal combination
-                    if(state->state == STATE_PLAYING) {
-                        FURI_LOG_W(TAG, "Secret code revealed by user");
-                        state->elapsed_time += furi_get_tick() - state->start_time;
-                        state->state = STATE_REVEAL;
-                    } else if(state->state == STATE_REVEAL) {
-                        FURI_LOG_I(TAG, "Hiding secret code");
-                        state->state = STATE_PLAYING;
-                        state->start_time = furi_get_tick();
-                    }
+        // Sleep until input, the clock or the hint worker, polling only for hint progress
+        uint32_t timeout = app->hint_running ? furi_ms_to_ticks(HINT_PROGRESS_MS) : FuriWaitForever;
+        bool ticked = false;
+        // Take whatever else is queued too, a burst of input costs one repaint
+        size_t count = 0;
+        while(count < EVENT_QUEUE_SIZE &&
+              furi_message_queue_get(event_queue, &events[count], count ? 0 : timeout) == FuriStatusOk) {
+            count++;
+        }
+        for(size_t i = 0; i < count && running; i++) {
+            const HirnEvent* event = &events[i];
+            const InputEvent* input = &event->input;
+            if(event->type == EventTypeClock) {
+                ticked = true;
+            } else if(event->type == EventTypeHint) {
+                apply_hint(app, &event->hint);
+                redraw.pending = true;
+            } else {
+                int steps = fold_repeats(events, count, &i);
+                running = handle_input(app, input, steps);
+                // Releases and short presses only follow a press that was handled already
+                if(input->type != InputTypeRelease && input->type != InputTypeShort) {
+                    redraw.pending = true;
+#ifdef HIRN_PROFILE
+                    // Folded repeats count from the first of them
+                    hirn_profile_record(HirnProfileInputToApply, hirn_profile_now() - event->stamp);
+                    if(!pending_stamp) pending_stamp = event->stamp | 1;  // Never 0, that means none
+#endif
                 }
             }
-            
-            view_port_update(view_port);
         }
+        if(count) update_conflict(app);
         
-        // Update display for timer
-        if(state->state == STATE_PLAYING) {
-            view_port_update(view_port);
-		}
-        // Check time limit
-        if(state->state == STATE_PLAYING) {
-            uint32_t current_time = state->elapsed_time + (furi_get_tick() - state->start_time);
-            if(current_time >= MAX_TIME_MS) {
-                FURI_LOG_W(TAG, "Time limit reached - game lost");
-                state->state = STATE_LOST;
-                state->elapsed_time = MAX_TIME_MS;
-                view_port_update(view_port);
+        // Check time limit, due exactly on a clock tick
+        if(check_time_limit(state)) {
+            redraw.pending = true;
+        }
+        update_clock(app, ticked);
+        // Repaint only if something visible changed
+        if(redraw_due(app, &redraw)) {
+            publish_render(app);
+#ifdef HIRN_PROFILE
+            // Unless a frame still has to show older input, this one times ours
+            unsigned none = 0;
+            if(pending_stamp) {
+                atomic_compare_exchange_strong_explicit(
+                    &app->shown_stamp, &none, pending_stamp, memory_order_release, memory_order_relaxed);
             }
+            pending_stamp = 0;
+#endif
+            view_port_update(view_port);
         }
-		
     }
-    FURI_LOG_I(TAG, "Cleaning up and exiting");
+    FURI_LOG_I(TAG, "Cleaning up and exiting (%lu redraws, %u inputs dropped)", redraw.frames,
+               atomic_load(&app->dropped_inputs));
+    stop_hint(app);
+    furi_thread_free(app->hint_thread);
+    furi_timer_free(app->clock_timer);  // Stops it, before the queue it posts to goes away
     gui_remove_view_port(gui, view_port);
     view_port_free(view_port);
     furi_record_close(RECORD_GUI);
     furi_message_queue_free(event_queue);
-    free(state);
+    HIRN_PROFILE_DUMP();
+    hirn_candidates_free(&app->candidates);
+    hirn_candidates_free(&app->hint_candidates);
+    free(app);
     FURI_LOG_I(TAG, "HIRN game stopped");
     
     return 0;
@@ -0,0 +1,22 @@
+#include "hirn_book.h"
+
+bool hirn_book_lookup(const CodeBreakerState* state, uint16_t* guess_index) {
+    for(uint32_t i = 0; i < hirn_book_size; i++) {
+        const HirnBookEntry* entry = &hirn_book[i];
+        const HirnVariant* variant = &state->variant;
+        if(entry->pegs != variant->pegs || entry->colors != variant->colors || entry->repeat != variant->repeat) {
+            continue;
+        }
+
+        uint16_t guess = HIRN_BOOK_NONE;
+        if(state->attempts_used == 0) {
+            guess = entry->first;
+        } else if(state->attempts_used == 1 && state->guess_history[0] == entry->first) {
+            guess = entry->second[state->feedback_history[0]];
+        }
+        if(guess == HIRN_BOOK_NONE) return false;
+        *guess_index = guess;
+        return true;
+    }
+    return false;
+}
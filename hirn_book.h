@@ -0,0 +1,28 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "hirn_game.h"
+
+// ============================================================================
+// Opening book: the unlimited hint answers for the first two turns of every
+// variant, computed offline by host/gen_book and shipped as const tables in
+// hirn_book_data.c.
+// ============================================================================
+
+#define HIRN_BOOK_NONE 0xFFFF  // Feedback class the opening can't produce
+
+typedef struct {
+    uint8_t pegs;
+    uint8_t colors;
+    bool repeat;
+    uint16_t first;          // Opening guess, code index
+    const uint16_t* second;  // Second guess per feedback class of the opening
+} HirnBookEntry;
+
+extern const HirnBookEntry hirn_book[];
+extern const uint32_t hirn_book_size;
+
+// Book guess for the current history, false once play has left the book
+bool hirn_book_lookup(const CodeBreakerState* state, uint16_t* guess_index);
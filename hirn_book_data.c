@@ -0,0 +1,691 @@
+// Generated by host/gen_book, do not edit. Regenerate with: make -C host book
+
+#include "hirn_book.h"
+
+// 3x4 without repetition, opening guess 1
+static const uint16_t book_3_4_unique[HIRN_FEEDBACK_CLASSES(3)] = {
+    HIRN_BOOK_NONE, // 0 black, 0 white: no candidates
+    27, // 0 black, 1 white: 6 candidates
+    24, // 0 black, 2 white: 4 candidates
+    HIRN_BOOK_NONE, // 0 black, 3 white: no candidates
+    11, // 1 black, 0 white: 6 candidates
+    6, // 1 black, 1 white: 4 candidates
+    HIRN_BOOK_NONE, // 1 black, 2 white: no candidates
+    9, // 2 black, 0 white: 4 candidates
+    HIRN_BOOK_NONE, // 3 black, 0 white: no candidates
+};
+
+// 3x4 with repetition, opening guess 6
+static const uint16_t book_3_4_repeat[HIRN_FEEDBACK_CLASSES(3)] = {
+    63, // 0 black, 0 white: 1 candidates
+    11, // 0 black, 1 white: 9 candidates
+    3, // 0 black, 2 white: 15 candidates
+    24, // 0 black, 3 white: 2 candidates
+    15, // 1 black, 0 white: 12 candidates
+    7, // 1 black, 1 white: 12 candidates
+    1, // 1 black, 2 white: 3 candidates
+    3, // 2 black, 0 white: 9 candidates
+    6, // 3 black, 0 white: 1 candidates
+};
+
+// 3x5 without repetition, opening guess 7
+static const uint16_t book_3_5_unique[HIRN_FEEDBACK_CLASSES(3)] = {
+    HIRN_BOOK_NONE, // 0 black, 0 white: no candidates
+    38, // 0 black, 1 white: 12 candidates
+    28, // 0 black, 2 white: 18 candidates
+    35, // 0 black, 3 white: 2 candidates
+    19, // 1 black, 0 white: 6 candidates
+    8, // 1 black, 1 white: 12 candidates
+    1, // 1 black, 2 white: 3 candidates
+    13, // 2 black, 0 white: 6 candidates
+    7, // 3 black, 0 white: 1 candidates
+};
+
+// 3x5 with repetition, opening guess 7
+static const uint16_t book_3_5_repeat[HIRN_FEEDBACK_CLASSES(3)] = {
+    18, // 0 black, 0 white: 8 candidates
+    44, // 0 black, 1 white: 30 candidates
+    44, // 0 black, 2 white: 24 candidates
+    35, // 0 black, 3 white: 2 candidates
+    38, // 1 black, 0 white: 27 candidates
+    8, // 1 black, 1 white: 18 candidates
+    1, // 1 black, 2 white: 3 candidates
+    13, // 2 black, 0 white: 12 candidates
+    7, // 3 black, 0 white: 1 candidates
+};
+
+// 3x6 without repetition, opening guess 8
+static const uint16_t book_3_6_unique[HIRN_FEEDBACK_CLASSES(3)] = {
+    130, // 0 black, 0 white: 6 candidates
+    39, // 0 black, 1 white: 36 candidates
+    51, // 0 black, 2 white: 27 candidates
+    48, // 0 black, 3 white: 2 candidates
+    9, // 1 black, 0 white: 18 candidates
+    9, // 1 black, 1 white: 18 candidates
+    1, // 1 black, 2 white: 3 candidates
+    15, // 2 black, 0 white: 9 candidates
+    8, // 3 black, 0 white: 1 candidates
+};
+
+// 3x6 with repetition, opening guess 8
+static const uint16_t book_3_6_repeat[HIRN_FEEDBACK_CLASSES(3)] = {
+    130, // 0 black, 0 white: 27 candidates
+    51, // 0 black, 1 white: 63 candidates
+    58, // 0 black, 2 white: 33 candidates
+    48, // 0 black, 3 white: 2 candidates
+    58, // 1 black, 0 white: 48 candidates
+    9, // 1 black, 1 white: 24 candidates
+    1, // 1 black, 2 white: 3 candidates
+    15, // 2 black, 0 white: 15 candidates
+    8, // 3 black, 0 white: 1 candidates
+};
+
+// 3x7 without repetition, opening guess 1
+static const uint16_t book_3_7_unique[HIRN_FEEDBACK_CLASSES(3)] = {
+    123, // 0 black, 0 white: 60 candidates
+    66, // 0 black, 1 white: 60 candidates
+    66, // 0 black, 2 white: 10 candidates
+    HIRN_BOOK_NONE, // 0 black, 3 white: no candidates
+    17, // 1 black, 0 white: 60 candidates
+    17, // 1 black, 1 white: 10 candidates
+    HIRN_BOOK_NONE, // 1 black, 2 white: no candidates
+    17, // 2 black, 0 white: 10 candidates
+    HIRN_BOOK_NONE, // 3 black, 0 white: no candidates
+};
+
+// 3x7 with repetition, opening guess 9
+static const uint16_t book_3_7_repeat[HIRN_FEEDBACK_CLASSES(3)] = {
+    180, // 0 black, 0 white: 64 candidates
+    66, // 0 black, 1 white: 108 candidates
+    74, // 0 black, 2 white: 42 candidates
+    63, // 0 black, 3 white: 2 candidates
+    25, // 1 black, 0 white: 75 candidates
+    10, // 1 black, 1 white: 30 candidates
+    1, // 1 black, 2 white: 3 candidates
+    17, // 2 black, 0 white: 18 candidates
+    9, // 3 black, 0 white: 1 candidates
+};
+
+// 3x8 without repetition, opening guess 10
+static const uint16_t book_3_8_unique[HIRN_FEEDBACK_CLASSES(3)] = {
+    229, // 0 black, 0 white: 60 candidates
+    67, // 0 black, 1 white: 120 candidates
+    83, // 0 black, 2 white: 45 candidates
+    80, // 0 black, 3 white: 2 candidates
+    19, // 1 black, 0 white: 60 candidates
+    11, // 1 black, 1 white: 30 candidates
+    1, // 1 black, 2 white: 3 candidates
+    19, // 2 black, 0 white: 15 candidates
+    10, // 3 black, 0 white: 1 candidates
+};
+
+// 3x8 with repetition, opening guess 10
+static const uint16_t book_3_8_repeat[HIRN_FEEDBACK_CLASSES(3)] = {
+    229, // 0 black, 0 white: 125 candidates
+    83, // 0 black, 1 white: 165 candidates
+    92, // 0 black, 2 white: 51 candidates
+    80, // 0 black, 3 white: 2 candidates
+    28, // 1 black, 0 white: 108 candidates
+    11, // 1 black, 1 white: 36 candidates
+    1, // 1 black, 2 white: 3 candidates
+    19, // 2 black, 0 white: 21 candidates
+    10, // 3 black, 0 white: 1 candidates
+};
+
+// 4x4 without repetition, opening guess 5
+static const uint16_t book_4_4_unique[HIRN_FEEDBACK_CLASSES(4)] = {
+    HIRN_BOOK_NONE, // 0 black, 0 white: no candidates
+    HIRN_BOOK_NONE, // 0 black, 1 white: no candidates
+    98, // 0 black, 2 white: 8 candidates
+    HIRN_BOOK_NONE, // 0 black, 3 white: no candidates
+    HIRN_BOOK_NONE, // 0 black, 4 white: no candidates
+    HIRN_BOOK_NONE, // 1 black, 0 white: no candidates
+    18, // 1 black, 1 white: 8 candidates
+    HIRN_BOOK_NONE, // 1 black, 2 white: no candidates
+    HIRN_BOOK_NONE, // 1 black, 3 white: no candidates
+    38, // 2 black, 0 white: 8 candidates
+    HIRN_BOOK_NONE, // 2 black, 1 white: no candidates
+    HIRN_BOOK_NONE, // 2 black, 2 white: no candidates
+    HIRN_BOOK_NONE, // 3 black, 0 white: no candidates
+    HIRN_BOOK_NONE, // 4 black, 0 white: no candidates
+};
+
+// 4x4 with repetition, opening guess 6
+static const uint16_t book_4_4_repeat[HIRN_FEEDBACK_CLASSES(4)] = {
+    255, // 0 black, 0 white: 1 candidates
+    247, // 0 black, 1 white: 16 candidates
+    241, // 0 black, 2 white: 42 candidates
+    120, // 0 black, 3 white: 20 candidates
+    96, // 0 black, 4 white: 2 candidates
+    59, // 1 black, 0 white: 18 candidates
+    51, // 1 black, 1 white: 46 candidates
+    25, // 1 black, 2 white: 40 candidates
+    24, // 1 black, 3 white: 4 candidates
+    51, // 2 black, 0 white: 29 candidates
+    20, // 2 black, 1 white: 20 candidates
+    18, // 2 black, 2 white: 5 candidates
+    23, // 3 black, 0 white: 12 candidates
+    6, // 4 black, 0 white: 1 candidates
+};
+
+// 4x5 without repetition, opening guess 6
+static const uint16_t book_4_5_unique[HIRN_FEEDBACK_CLASSES(4)] = {
+    HIRN_BOOK_NONE, // 0 black, 0 white: no candidates
+    194, // 0 black, 1 white: 24 candidates
+    177, // 0 black, 2 white: 24 candidates
+    HIRN_BOOK_NONE, // 0 black, 3 white: no candidates
+    HIRN_BOOK_NONE, // 0 black, 4 white: no candidates
+    69, // 1 black, 0 white: 24 candidates
+    27, // 1 black, 1 white: 24 candidates
+    HIRN_BOOK_NONE, // 1 black, 2 white: no candidates
+    HIRN_BOOK_NONE, // 1 black, 3 white: no candidates
+    57, // 2 black, 0 white: 24 candidates
+    HIRN_BOOK_NONE, // 2 black, 1 white: no candidates
+    HIRN_BOOK_NONE, // 2 black, 2 white: no candidates
+    HIRN_BOOK_NONE, // 3 black, 0 white: no candidates
+    HIRN_BOOK_NONE, // 4 black, 0 white: no candidates
+};
+
+// 4x5 with repetition, opening guess 6
+static const uint16_t book_4_5_repeat[HIRN_FEEDBACK_CLASSES(4)] = {
+    313, // 0 black, 0 white: 81 candidates
+    177, // 0 black, 1 white: 108 candidates
+    178, // 0 black, 2 white: 54 candidates
+    27, // 0 black, 3 white: 12 candidates
+    150, // 0 black, 4 white: 1 candidates
+    57, // 1 black, 0 white: 108 candidates
+    50, // 1 black, 1 white: 120 candidates
+    27, // 1 black, 2 white: 28 candidates
+    HIRN_BOOK_NONE, // 1 black, 3 white: no candidates
+    52, // 2 black, 0 white: 68 candidates
+    32, // 2 black, 1 white: 24 candidates
+    27, // 2 black, 2 white: 4 candidates
+    13, // 3 black, 0 white: 16 candidates
+    6, // 4 black, 0 white: 1 candidates
+};
+
+// 4x6 without repetition, opening guess 51
+static const uint16_t book_4_6_unique[HIRN_FEEDBACK_CLASSES(4)] = {
+    HIRN_BOOK_NONE, // 0 black, 0 white: no candidates
+    HIRN_BOOK_NONE, // 0 black, 1 white: no candidates
+    173, // 0 black, 2 white: 84 candidates
+    310, // 0 black, 3 white: 88 candidates
+    1, // 0 black, 4 white: 9 candidates
+    HIRN_BOOK_NONE, // 1 black, 0 white: no candidates
+    173, // 1 black, 1 white: 48 candidates
+    58, // 1 black, 2 white: 72 candidates
+    8, // 1 black, 3 white: 8 candidates
+    94, // 2 black, 0 white: 12 candidates
+    16, // 2 black, 1 white: 24 candidates
+    7, // 2 black, 2 white: 6 candidates
+    16, // 3 black, 0 white: 8 candidates
+    51, // 4 black, 0 white: 1 candidates
+};
+
+// 4x6 with repetition, opening guess 7
+static const uint16_t book_4_6_repeat[HIRN_FEEDBACK_CLASSES(4)] = {
+    526, // 0 black, 0 white: 256 candidates
+    309, // 0 black, 1 white: 256 candidates
+    309, // 0 black, 2 white: 96 candidates
+    38, // 0 black, 3 white: 16 candidates
+    252, // 0 black, 4 white: 1 candidates
+    93, // 1 black, 0 white: 256 candidates
+    15, // 1 black, 1 white: 208 candidates
+    38, // 1 black, 2 white: 36 candidates
+    HIRN_BOOK_NONE, // 1 black, 3 white: no candidates
+    51, // 2 black, 0 white: 114 candidates
+    44, // 2 black, 1 white: 32 candidates
+    38, // 2 black, 2 white: 4 candidates
+    44, // 3 black, 0 white: 20 candidates
+    7, // 4 black, 0 white: 1 candidates
+};
+
+// 4x7 without repetition, opening guess 9
+static const uint16_t book_4_7_unique[HIRN_FEEDBACK_CLASSES(4)] = {
+    1208, // 0 black, 0 white: 24 candidates
+    493, // 0 black, 1 white: 192 candidates
+    395, // 0 black, 2 white: 204 candidates
+    518, // 0 black, 3 white: 32 candidates
+    HIRN_BOOK_NONE, // 0 black, 4 white: no candidates
+    179, // 1 black, 0 white: 96 candidates
+    17, // 1 black, 1 white: 168 candidates
+    151, // 1 black, 2 white: 40 candidates
+    HIRN_BOOK_NONE, // 1 black, 3 white: no candidates
+    149, // 2 black, 0 white: 60 candidates
+    74, // 2 black, 1 white: 16 candidates
+    HIRN_BOOK_NONE, // 2 black, 2 white: no candidates
+    74, // 3 black, 0 white: 8 candidates
+    HIRN_BOOK_NONE, // 4 black, 0 white: no candidates
+};
+
+// 4x7 with repetition, opening guess 75
+static const uint16_t book_4_7_repeat[HIRN_FEEDBACK_CLASSES(4)] = {
+    802, // 0 black, 0 white: 81 candidates
+    116, // 0 black, 1 white: 444 candidates
+    442, // 0 black, 2 white: 582 candidates
+    442, // 0 black, 3 white: 180 candidates
+    1, // 0 black, 4 white: 9 candidates
+    816, // 1 black, 0 white: 256 candidates
+    67, // 1 black, 1 white: 432 candidates
+    8, // 1 black, 2 white: 168 candidates
+    10, // 1 black, 3 white: 8 candidates
+    109, // 2 black, 0 white: 150 candidates
+    8, // 2 black, 1 white: 60 candidates
+    8, // 2 black, 2 white: 6 candidates
+    8, // 3 black, 0 white: 24 candidates
+    75, // 4 black, 0 white: 1 candidates
+};
+
+// 4x8 without repetition, opening guess 620
+static const uint16_t book_4_8_unique[HIRN_FEEDBACK_CLASSES(4)] = {
+    18, // 0 black, 0 white: 120 candidates
+    141, // 0 black, 1 white: 480 candidates
+    293, // 0 black, 2 white: 340 candidates
+    266, // 0 black, 3 white: 40 candidates
+    HIRN_BOOK_NONE, // 0 black, 4 white: no candidates
+    66, // 1 black, 0 white: 240 candidates
+    68, // 1 black, 1 white: 280 candidates
+    165, // 1 black, 2 white: 50 candidates
+    HIRN_BOOK_NONE, // 1 black, 3 white: no candidates
+    66, // 2 black, 0 white: 100 candidates
+    20, // 2 black, 1 white: 20 candidates
+    HIRN_BOOK_NONE, // 2 black, 2 white: no candidates
+    66, // 3 black, 0 white: 10 candidates
+    HIRN_BOOK_NONE, // 4 black, 0 white: no candidates
+};
+
+// 4x8 with repetition, opening guess 12
+static const uint16_t book_4_8_repeat[HIRN_FEEDBACK_CLASSES(4)] = {
+    1179, // 0 black, 0 white: 625 candidates
+    669, // 0 black, 1 white: 1160 candidates
+    1249, // 0 black, 2 white: 546 candidates
+    769, // 0 black, 3 white: 68 candidates
+    768, // 0 black, 4 white: 2 candidates
+    1220, // 1 black, 0 white: 682 candidates
+    66, // 1 black, 1 white: 558 candidates
+    97, // 1 black, 2 white: 128 candidates
+    96, // 1 black, 3 white: 4 candidates
+    131, // 2 black, 0 white: 229 candidates
+    161, // 2 black, 1 white: 60 candidates
+    68, // 2 black, 2 white: 5 candidates
+    84, // 3 black, 0 white: 28 candidates
+    12, // 4 black, 0 white: 1 candidates
+};
+
+// 5x4 with repetition, opening guess 6
+static const uint16_t book_5_4_repeat[HIRN_FEEDBACK_CLASSES(5)] = {
+    1023, // 0 black, 0 white: 1 candidates
+    511, // 0 black, 1 white: 32 candidates
+    1009, // 0 black, 2 white: 122 candidates
+    360, // 0 black, 3 white: 76 candidates
+    354, // 0 black, 4 white: 12 candidates
+    HIRN_BOOK_NONE, // 0 black, 5 white: no candidates
+    503, // 1 black, 0 white: 35 candidates
+    247, // 1 black, 1 white: 140 candidates
+    240, // 1 black, 2 white: 164 candidates
+    88, // 1 black, 3 white: 60 candidates
+    16, // 1 black, 4 white: 6 candidates
+    63, // 2 black, 0 white: 78 candidates
+    89, // 2 black, 1 white: 111 candidates
+    90, // 2 black, 2 white: 75 candidates
+    24, // 2 black, 3 white: 6 candidates
+    95, // 3 black, 0 white: 55 candidates
+    105, // 3 black, 1 white: 28 candidates
+    18, // 3 black, 2 white: 7 candidates
+    90, // 4 black, 0 white: 15 candidates
+    6, // 5 black, 0 white: 1 candidates
+};
+
+// 5x5 without repetition, opening guess 194
+static const uint16_t book_5_5_unique[HIRN_FEEDBACK_CLASSES(5)] = {
+    HIRN_BOOK_NONE, // 0 black, 0 white: no candidates
+    HIRN_BOOK_NONE, // 0 black, 1 white: no candidates
+    HIRN_BOOK_NONE, // 0 black, 2 white: no candidates
+    HIRN_BOOK_NONE, // 0 black, 3 white: no candidates
+    HIRN_BOOK_NONE, // 0 black, 4 white: no candidates
+    970, // 0 black, 5 white: 44 candidates
+    HIRN_BOOK_NONE, // 1 black, 0 white: no candidates
+    HIRN_BOOK_NONE, // 1 black, 1 white: no candidates
+    HIRN_BOOK_NONE, // 1 black, 2 white: no candidates
+    HIRN_BOOK_NONE, // 1 black, 3 white: no candidates
+    31, // 1 black, 4 white: 45 candidates
+    HIRN_BOOK_NONE, // 2 black, 0 white: no candidates
+    HIRN_BOOK_NONE, // 2 black, 1 white: no candidates
+    HIRN_BOOK_NONE, // 2 black, 2 white: no candidates
+    212, // 2 black, 3 white: 20 candidates
+    HIRN_BOOK_NONE, // 3 black, 0 white: no candidates
+    HIRN_BOOK_NONE, // 3 black, 1 white: no candidates
+    9, // 3 black, 2 white: 10 candidates
+    HIRN_BOOK_NONE, // 4 black, 0 white: no candidates
+    194, // 5 black, 0 white: 1 candidates
+};
+
+// 5x5 with repetition, opening guess 18
+static const uint16_t book_5_5_repeat[HIRN_FEEDBACK_CLASSES(5)] = {
+    157, // 0 black, 0 white: 243 candidates
+    1087, // 0 black, 1 white: 405 candidates
+    827, // 0 black, 2 white: 279 candidates
+    1077, // 0 black, 3 white: 87 candidates
+    202, // 0 black, 4 white: 10 candidates
+    HIRN_BOOK_NONE, // 0 black, 5 white: no candidates
+    37, // 1 black, 0 white: 405 candidates
+    176, // 1 black, 1 white: 600 candidates
+    468, // 1 black, 2 white: 236 candidates
+    451, // 1 black, 3 white: 36 candidates
+    200, // 1 black, 4 white: 3 candidates
+    163, // 2 black, 0 white: 307 candidates
+    457, // 2 black, 1 white: 270 candidates
+    76, // 2 black, 2 white: 63 candidates
+    HIRN_BOOK_NONE, // 2 black, 3 white: no candidates
+    39, // 3 black, 0 white: 118 candidates
+    28, // 3 black, 1 white: 36 candidates
+    28, // 3 black, 2 white: 6 candidates
+    27, // 4 black, 0 white: 20 candidates
+    18, // 5 black, 0 white: 1 candidates
+};
+
+// 5x6 without repetition, opening guess 8
+static const uint16_t book_5_6_unique[HIRN_FEEDBACK_CLASSES(5)] = {
+    HIRN_BOOK_NONE, // 0 black, 0 white: no candidates
+    HIRN_BOOK_NONE, // 0 black, 1 white: no candidates
+    4684, // 0 black, 2 white: 162 candidates
+    270, // 0 black, 3 white: 108 candidates
+    HIRN_BOOK_NONE, // 0 black, 4 white: no candidates
+    HIRN_BOOK_NONE, // 0 black, 5 white: no candidates
+    HIRN_BOOK_NONE, // 1 black, 0 white: no candidates
+    117, // 1 black, 1 white: 156 candidates
+    15, // 1 black, 2 white: 162 candidates
+    HIRN_BOOK_NONE, // 1 black, 3 white: no candidates
+    HIRN_BOOK_NONE, // 1 black, 4 white: no candidates
+    123, // 2 black, 0 white: 42 candidates
+    297, // 2 black, 1 white: 72 candidates
+    HIRN_BOOK_NONE, // 2 black, 2 white: no candidates
+    HIRN_BOOK_NONE, // 2 black, 3 white: no candidates
+    108, // 3 black, 0 white: 18 candidates
+    HIRN_BOOK_NONE, // 3 black, 1 white: no candidates
+    HIRN_BOOK_NONE, // 3 black, 2 white: no candidates
+    HIRN_BOOK_NONE, // 4 black, 0 white: no candidates
+    HIRN_BOOK_NONE, // 5 black, 0 white: no candidates
+};
+
+// 5x6 with repetition, opening guess 1604
+static const uint16_t book_5_6_repeat[HIRN_FEEDBACK_CLASSES(5)] = {
+    10, // 0 black, 0 white: 243 candidates
+    457, // 0 black, 1 white: 1011 candidates
+    51, // 0 black, 2 white: 1190 candidates
+    45, // 0 black, 3 white: 574 candidates
+    477, // 0 black, 4 white: 103 candidates
+    441, // 0 black, 5 white: 4 candidates
+    292, // 1 black, 0 white: 580 candidates
+    7223, // 1 black, 1 white: 1360 candidates
+    61, // 1 black, 2 white: 984 candidates
+    488, // 1 black, 3 white: 192 candidates
+    1779, // 1 black, 4 white: 9 candidates
+    75, // 2 black, 0 white: 492 candidates
+    951, // 2 black, 1 white: 564 candidates
+    1803, // 2 black, 2 white: 186 candidates
+    265, // 2 black, 3 white: 8 candidates
+    262, // 3 black, 0 white: 178 candidates
+    339, // 3 black, 1 white: 64 candidates
+    1779, // 3 black, 2 white: 8 candidates
+    260, // 4 black, 0 white: 25 candidates
+    1604, // 5 black, 0 white: 1 candidates
+};
+
+// 5x7 without repetition, opening guess 468
+static const uint16_t book_5_7_unique[HIRN_FEEDBACK_CLASSES(5)] = {
+    HIRN_BOOK_NONE, // 0 black, 0 white: no candidates
+    HIRN_BOOK_NONE, // 0 black, 1 white: no candidates
+    HIRN_BOOK_NONE, // 0 black, 2 white: no candidates
+    3862, // 0 black, 3 white: 640 candidates
+    2566, // 0 black, 4 white: 530 candidates
+    3276, // 0 black, 5 white: 44 candidates
+    HIRN_BOOK_NONE, // 1 black, 0 white: no candidates
+    HIRN_BOOK_NONE, // 1 black, 1 white: no candidates
+    3855, // 1 black, 2 white: 420 candidates
+    74, // 1 black, 3 white: 440 candidates
+    57, // 1 black, 4 white: 45 candidates
+    HIRN_BOOK_NONE, // 2 black, 0 white: no candidates
+    1601, // 2 black, 1 white: 120 candidates
+    80, // 2 black, 2 white: 180 candidates
+    506, // 2 black, 3 white: 20 candidates
+    913, // 3 black, 0 white: 20 candidates
+    844, // 3 black, 1 white: 40 candidates
+    13, // 3 black, 2 white: 10 candidates
+    129, // 4 black, 0 white: 10 candidates
+    468, // 5 black, 0 white: 1 candidates
+};
+
+// 5x7 with repetition, opening guess 3931
+static const uint16_t book_5_7_repeat[HIRN_FEEDBACK_CLASSES(5)] = {
+    19, // 0 black, 0 white: 1024 candidates
+    14381, // 0 black, 1 white: 3012 candidates
+    8125, // 0 black, 2 white: 2642 candidates
+    7577, // 0 black, 3 white: 962 candidates
+    423, // 0 black, 4 white: 132 candidates
+    80, // 0 black, 5 white: 4 candidates
+    5311, // 1 black, 0 white: 1649 candidates
+    4264, // 1 black, 1 white: 2964 candidates
+    7417, // 1 black, 2 white: 1614 candidates
+    522, // 1 black, 3 white: 244 candidates
+    2971, // 1 black, 4 white: 9 candidates
+    1039, // 2 black, 0 white: 1006 candidates
+    1243, // 2 black, 1 white: 912 candidates
+    2769, // 2 black, 2 white: 234 candidates
+    547, // 2 black, 3 white: 8 candidates
+    3440, // 3 black, 0 white: 272 candidates
+    410, // 3 black, 1 white: 80 candidates
+    2971, // 3 black, 2 white: 8 candidates
+    403, // 4 black, 0 white: 30 candidates
+    3931, // 5 black, 0 white: 1 candidates
+};
+
+// 5x8 without repetition, opening guess 3152
+static const uint16_t book_5_8_unique[HIRN_FEEDBACK_CLASSES(5)] = {
+    HIRN_BOOK_NONE, // 0 black, 0 white: no candidates
+    13212, // 0 black, 1 white: 360 candidates
+    20851, // 0 black, 2 white: 1656 candidates
+    12300, // 0 black, 3 white: 1284 candidates
+    4300, // 0 black, 4 white: 168 candidates
+    HIRN_BOOK_NONE, // 0 black, 5 white: no candidates
+    739, // 1 black, 0 white: 120 candidates
+    1635, // 1 black, 1 white: 1008 candidates
+    604, // 1 black, 2 white: 1116 candidates
+    156, // 1 black, 3 white: 184 candidates
+    HIRN_BOOK_NONE, // 1 black, 4 white: no candidates
+    739, // 2 black, 0 white: 216 candidates
+    1635, // 2 black, 1 white: 396 candidates
+    12916, // 2 black, 2 white: 96 candidates
+    HIRN_BOOK_NONE, // 2 black, 3 white: no candidates
+    92, // 3 black, 0 white: 84 candidates
+    5905, // 3 black, 1 white: 24 candidates
+    HIRN_BOOK_NONE, // 3 black, 2 white: no candidates
+    28, // 4 black, 0 white: 8 candidates
+    HIRN_BOOK_NONE, // 5 black, 0 white: no candidates
+};
+
+// 5x8 with repetition, opening guess 14632
+static const uint16_t book_5_8_repeat[HIRN_FEEDBACK_CLASSES(5)] = {
+    4694, // 0 black, 0 white: 1024 candidates
+    596, // 0 black, 1 white: 5196 candidates
+    29427, // 0 black, 2 white: 7051 candidates
+    2591, // 0 black, 3 white: 3095 candidates
+    867, // 0 black, 4 white: 429 candidates
+    1892, // 0 black, 5 white: 12 candidates
+    19568, // 1 black, 0 white: 2387 candidates
+    14463, // 1 black, 1 white: 5432 candidates
+    17316, // 1 black, 2 white: 3510 candidates
+    301, // 1 black, 3 white: 652 candidates
+    2333, // 1 black, 4 white: 24 candidates
+    30124, // 2 black, 0 white: 1523 candidates
+    10598, // 2 black, 1 white: 1497 candidates
+    283, // 2 black, 2 white: 396 candidates
+    772, // 2 black, 3 white: 14 candidates
+    5412, // 3 black, 0 white: 373 candidates
+    283, // 3 black, 1 white: 108 candidates
+    45, // 3 black, 2 white: 9 candidates
+    297, // 4 black, 0 white: 35 candidates
+    14632, // 5 black, 0 white: 1 candidates
+};
+
+// 6x4 with repetition, opening guess 365
+static const uint16_t book_6_4_repeat[HIRN_FEEDBACK_CLASSES(6)] = {
+    HIRN_BOOK_NONE, // 0 black, 0 white: no candidates
+    HIRN_BOOK_NONE, // 0 black, 1 white: no candidates
+    2179, // 0 black, 2 white: 51 candidates
+    2096, // 0 black, 3 white: 288 candidates
+    1155, // 0 black, 4 white: 294 candidates
+    1211, // 0 black, 5 white: 90 candidates
+    2, // 0 black, 6 white: 6 candidates
+    2, // 1 black, 0 white: 3 candidates
+    43, // 1 black, 1 white: 96 candidates
+    698, // 1 black, 2 white: 447 candidates
+    642, // 1 black, 3 white: 561 candidates
+    1667, // 1 black, 4 white: 315 candidates
+    1154, // 1 black, 5 white: 36 candidates
+    11, // 2 black, 0 white: 57 candidates
+    131, // 2 black, 1 white: 282 candidates
+    442, // 2 black, 2 white: 507 candidates
+    330, // 2 black, 3 white: 324 candidates
+    414, // 2 black, 4 white: 45 candidates
+    10, // 3 black, 0 white: 109 candidates
+    386, // 3 black, 1 white: 216 candidates
+    90, // 3 black, 2 white: 195 candidates
+    30, // 3 black, 3 white: 20 candidates
+    74, // 4 black, 0 white: 75 candidates
+    394, // 4 black, 1 white: 48 candidates
+    29, // 4 black, 2 white: 12 candidates
+    74, // 5 black, 0 white: 18 candidates
+    365, // 6 black, 0 white: 1 candidates
+};
+
+// 6x5 with repetition, opening guess 7336
+static const uint16_t book_6_5_repeat[HIRN_FEEDBACK_CLASSES(6)] = {
+    9, // 0 black, 0 white: 64 candidates
+    9, // 0 black, 1 white: 384 candidates
+    42, // 0 black, 2 white: 1068 candidates
+    32, // 0 black, 3 white: 1448 candidates
+    1428, // 0 black, 4 white: 918 candidates
+    1442, // 0 black, 5 white: 204 candidates
+    4568, // 0 black, 6 white: 10 candidates
+    14, // 1 black, 0 white: 192 candidates
+    15586, // 1 black, 1 white: 1356 candidates
+    14473, // 1 black, 2 white: 2412 candidates
+    231, // 1 black, 3 white: 1716 candidates
+    966, // 1 black, 4 white: 444 candidates
+    1412, // 1 black, 5 white: 24 candidates
+    474, // 2 black, 0 white: 435 candidates
+    8010, // 2 black, 1 white: 1428 candidates
+    927, // 2 black, 2 white: 1530 candidates
+    957, // 2 black, 3 white: 420 candidates
+    813, // 2 black, 4 white: 27 candidates
+    801, // 3 black, 0 white: 388 candidates
+    161, // 3 black, 1 white: 600 candidates
+    957, // 3 black, 2 white: 276 candidates
+    828, // 3 black, 3 white: 16 candidates
+    171, // 4 black, 0 white: 156 candidates
+    788, // 4 black, 1 white: 72 candidates
+    4067, // 4 black, 2 white: 12 candidates
+    814, // 5 black, 0 white: 24 candidates
+    7336, // 6 black, 0 white: 1 candidates
+};
+
+// 6x6 without repetition, opening guess 1865
+static const uint16_t book_6_6_unique[HIRN_FEEDBACK_CLASSES(6)] = {
+    HIRN_BOOK_NONE, // 0 black, 0 white: no candidates
+    HIRN_BOOK_NONE, // 0 black, 1 white: no candidates
+    HIRN_BOOK_NONE, // 0 black, 2 white: no candidates
+    HIRN_BOOK_NONE, // 0 black, 3 white: no candidates
+    HIRN_BOOK_NONE, // 0 black, 4 white: no candidates
+    HIRN_BOOK_NONE, // 0 black, 5 white: no candidates
+    10545, // 0 black, 6 white: 265 candidates
+    HIRN_BOOK_NONE, // 1 black, 0 white: no candidates
+    HIRN_BOOK_NONE, // 1 black, 1 white: no candidates
+    HIRN_BOOK_NONE, // 1 black, 2 white: no candidates
+    HIRN_BOOK_NONE, // 1 black, 3 white: no candidates
+    HIRN_BOOK_NONE, // 1 black, 4 white: no candidates
+    281, // 1 black, 5 white: 264 candidates
+    HIRN_BOOK_NONE, // 2 black, 0 white: no candidates
+    HIRN_BOOK_NONE, // 2 black, 1 white: no candidates
+    HIRN_BOOK_NONE, // 2 black, 2 white: no candidates
+    HIRN_BOOK_NONE, // 2 black, 3 white: no candidates
+    2030, // 2 black, 4 white: 135 candidates
+    HIRN_BOOK_NONE, // 3 black, 0 white: no candidates
+    HIRN_BOOK_NONE, // 3 black, 1 white: no candidates
+    HIRN_BOOK_NONE, // 3 black, 2 white: no candidates
+    266, // 3 black, 3 white: 40 candidates
+    HIRN_BOOK_NONE, // 4 black, 0 white: no candidates
+    HIRN_BOOK_NONE, // 4 black, 1 white: no candidates
+    3283, // 4 black, 2 white: 15 candidates
+    HIRN_BOOK_NONE, // 5 black, 0 white: no candidates
+    1865, // 6 black, 0 white: 1 candidates
+};
+
+// 6x6 with repetition, opening guess 9597
+static const uint16_t book_6_6_repeat[HIRN_FEEDBACK_CLASSES(6)] = {
+    4, // 0 black, 0 white: 729 candidates
+    21774, // 0 black, 1 white: 2916 candidates
+    24217, // 0 black, 2 white: 5211 candidates
+    16392, // 0 black, 3 white: 4572 candidates
+    332, // 0 black, 4 white: 1899 candidates
+    3358, // 0 black, 5 white: 288 candidates
+    19772, // 0 black, 6 white: 10 candidates
+    37467, // 1 black, 0 white: 1458 candidates
+    33363, // 1 black, 1 white: 6066 candidates
+    18724, // 1 black, 2 white: 7140 candidates
+    37028, // 1 black, 3 white: 3444 candidates
+    2066, // 1 black, 4 white: 618 candidates
+    1562, // 1 black, 5 white: 24 candidates
+    12846, // 2 black, 0 white: 1740 candidates
+    1638, // 2 black, 1 white: 4080 candidates
+    10452, // 2 black, 2 white: 2952 candidates
+    3147, // 2 black, 3 white: 576 candidates
+    1635, // 2 black, 4 white: 27 candidates
+    381, // 3 black, 0 white: 984 candidates
+    261, // 3 black, 1 white: 1128 candidates
+    5445, // 3 black, 2 white: 372 candidates
+    297, // 3 black, 3 white: 16 candidates
+    598, // 4 black, 0 white: 267 candidates
+    1570, // 4 black, 1 white: 96 candidates
+    10706, // 4 black, 2 white: 12 candidates
+    1642, // 5 black, 0 white: 30 candidates
+    9597, // 6 black, 0 white: 1 candidates
+};
+
+const HirnBookEntry hirn_book[] = {
+    {3, 4, false, 1, book_3_4_unique},
+    {3, 4, true, 6, book_3_4_repeat},
+    {3, 5, false, 7, book_3_5_unique},
+    {3, 5, true, 7, book_3_5_repeat},
+    {3, 6, false, 8, book_3_6_unique},
+    {3, 6, true, 8, book_3_6_repeat},
+    {3, 7, false, 1, book_3_7_unique},
+    {3, 7, true, 9, book_3_7_repeat},
+    {3, 8, false, 10, book_3_8_unique},
+    {3, 8, true, 10, book_3_8_repeat},
+    {4, 4, false, 5, book_4_4_unique},
+    {4, 4, true, 6, book_4_4_repeat},
+    {4, 5, false, 6, book_4_5_unique},
+    {4, 5, true, 6, book_4_5_repeat},
+    {4, 6, false, 51, book_4_6_unique},
+    {4, 6, true, 7, book_4_6_repeat},
+    {4, 7, false, 9, book_4_7_unique},
+    {4, 7, true, 75, book_4_7_repeat},
+    {4, 8, false, 620, book_4_8_unique},
+    {4, 8, true, 12, book_4_8_repeat},
+    {5, 4, true, 6, book_5_4_repeat},
+    {5, 5, false, 194, book_5_5_unique},
+    {5, 5, true, 18, book_5_5_repeat},
+    {5, 6, false, 8, book_5_6_unique},
+    {5, 6, true, 1604, book_5_6_repeat},
+    {5, 7, false, 468, book_5_7_unique},
+    {5, 7, true, 3931, book_5_7_repeat},
+    {5, 8, false, 3152, book_5_8_unique},
+    {5, 8, true, 14632, book_5_8_repeat},
+    {6, 4, true, 365, book_6_4_repeat},
+    {6, 5, true, 7336, book_6_5_repeat},
+    {6, 6, false, 1865, book_6_6_unique},
+    {6, 6, true, 9597, book_6_6_repeat},
+};
+
+const uint32_t hirn_book_size = sizeof(hirn_book) / sizeof(hirn_book[0]);
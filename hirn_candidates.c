@@ -0,0 +1,114 @@
+#include "hirn_candidates.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================================
+// Kernels, one per shape of HIRN_SHAPES with the peg and color counts as
+// constants: the index decoding divides by a constant and the peg loops unroll.
+// ============================================================================
+
+typedef void (*ResetKernel)(HirnCandidates* candidates, bool repeat);
+typedef void (*FilterKernel)(HirnCandidates* candidates, HirnCode guess, HirnScore expected);
+
+static inline __attribute__((always_inline)) void reset_kernel(
+    HirnCandidates* candidates, bool repeat, int pegs, int colors) {
+    uint32_t space = 1;
+    for(int i = 0; i < pegs; i++) {
+        space *= colors;
+    }
+    memset(candidates->bits, 0, candidates->words * sizeof(uint32_t));
+    if(repeat) {
+        memset(candidates->bits, 0xFF, (space / 32) * sizeof(uint32_t));
+        if(space % 32) candidates->bits[space / 32] = (1u << (space % 32)) - 1;
+        candidates->count = space;
+        return;
+    }
+    // Only the repetition-free codes, straight from their ranks
+    uint32_t ranks = 1;
+    for(int i = 0; i < pegs; i++) {
+        ranks *= colors - i;
+    }
+    for(uint32_t rank = 0; rank < ranks; rank++) {
+        uint16_t index = hirn_code_index_of(hirn_code_permutation_unrank_of(rank, pegs, colors), pegs, colors);
+        candidates->bits[index / 32] |= 1u << (index % 32);
+    }
+    candidates->count = ranks;
+}
+
+static inline __attribute__((always_inline)) void filter_kernel(
+    HirnCandidates* candidates, HirnCode guess, HirnScore expected, int pegs, int colors) {
+    uint32_t guess_histogram = hirn_code_histogram(guess, pegs);
+    uint16_t count = 0;
+
+    for(uint32_t word = 0; word < candidates->words; word++) {
+        uint32_t bits = candidates->bits[word];
+        uint32_t keep = bits;
+        while(bits) {
+            uint32_t bit = __builtin_ctz(bits);
+            bits &= bits - 1;
+            HirnCode code = hirn_code_from_index_of(word * 32 + bit, pegs, colors);
+            HirnScore score =
+                hirn_score_histograms(code, hirn_code_histogram(code, pegs), guess, guess_histogram, pegs);
+            // Clear the bit unless the scores agree
+            keep &= ~((uint32_t)(score != expected) << bit);
+        }
+        candidates->bits[word] = keep;
+        count += __builtin_popcount(keep);
+    }
+    candidates->count = count;
+}
+
+#define RESET_KERNEL(pegs, colors)                                                   \
+    static void reset_##pegs##_##colors(HirnCandidates* candidates, bool repeat) { \
+        reset_kernel(candidates, repeat, pegs, colors);                            \
+    }
+HIRN_SHAPES(RESET_KERNEL)
+
+#define FILTER_KERNEL(pegs, colors)                                                                         \
+    static void filter_##pegs##_##colors(HirnCandidates* candidates, HirnCode guess, HirnScore expected) { \
+        filter_kernel(candidates, guess, expected, pegs, colors);                                         \
+    }
+HIRN_SHAPES(FILTER_KERNEL)
+
+#define RESET_SLOT(pegs, colors) [HIRN_SHAPE_INDEX(pegs, colors)] = reset_##pegs##_##colors,
+#define FILTER_SLOT(pegs, colors) [HIRN_SHAPE_INDEX(pegs, colors)] = filter_##pegs##_##colors,
+static const ResetKernel reset_kernels[HIRN_SHAPE_SLOTS] = {HIRN_SHAPES(RESET_SLOT)};
+static const FilterKernel filter_kernels[HIRN_SHAPE_SLOTS] = {HIRN_SHAPES(FILTER_SLOT)};
+
+// ============================================================================
+// Candidate Set
+// ============================================================================
+
+// Bits for words words, reallocated only when the size changes
+static void resize(HirnCandidates* candidates, uint16_t words) {
+    if(candidates->bits && candidates->words == words) return;
+    free(candidates->bits);
+    candidates->bits = malloc(words * sizeof(uint32_t));
+    candidates->words = words;
+}
+
+void hirn_candidates_reset(HirnCandidates* candidates, HirnVariant variant) {
+    resize(candidates, (hirn_code_space(variant) + 31) / 32);
+    candidates->variant = variant;
+    reset_kernels[HIRN_SHAPE_INDEX(variant.pegs, variant.colors)](candidates, variant.repeat);
+}
+
+void hirn_candidates_copy(HirnCandidates* to, const HirnCandidates* from) {
+    resize(to, from->words);
+    to->variant = from->variant;
+    to->count = from->count;
+    memcpy(to->bits, from->bits, from->words * sizeof(uint32_t));
+}
+
+void hirn_candidates_free(HirnCandidates* candidates) {
+    free(candidates->bits);
+    candidates->bits = NULL;
+    candidates->words = 0;
+}
+
+void hirn_candidates_filter(HirnCandidates* candidates, HirnCode guess, FeedbackClass feedback) {
+    HirnVariant variant = candidates->variant;
+    HirnScore expected = hirn_feedback_score(feedback, variant.pegs);
+    filter_kernels[HIRN_SHAPE_INDEX(variant.pegs, variant.colors)](candidates, guess, expected);
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "hirn_code.h"
+
+// ============================================================================
+// Candidate set: one bit per code index, set while the code is still
+// consistent with every guess and feedback seen so far. Filtering is
+// incremental, each guess only re-scores the surviving candidates.
+// ============================================================================
+
+// The bits live on the heap, sized for the variant: 164 bytes for the
+// classic game, up to about 5.8 KB for the largest. Zeroed memory is an
+// empty set without storage; a set is copied with hirn_candidates_copy, not
+// by assignment, and released with hirn_candidates_free.
+typedef struct {
+    HirnVariant variant;
+    uint16_t count;
+    uint16_t words;  // Words of bits, (code space + 31) / 32
+    uint32_t* bits;
+} HirnCandidates;
+
+// Start over with every possible secret of variant (only repetition-free codes unless it repeats)
+void hirn_candidates_reset(HirnCandidates* candidates, HirnVariant variant);
+
+// Make to an independent copy of from
+void hirn_candidates_copy(HirnCandidates* to, const HirnCandidates* from);
+
+void hirn_candidates_free(HirnCandidates* candidates);
+
+// Drop every candidate that would not have produced feedback for guess
+void hirn_candidates_filter(HirnCandidates* candidates, HirnCode guess, FeedbackClass feedback);
+
+static inline bool hirn_candidates_contains(const HirnCandidates* candidates, uint16_t index) {
+    return (candidates->bits[index / 32] >> (index % 32)) & 1;
+}
+
+// True if code has no repeated color
+static inline bool hirn_code_is_repetition_free(HirnCode code, int pegs) {
+    // Every count nibble must be 0 or 1
+    return (hirn_code_histogram(code, pegs) & (HIRN_NIBBLE_LSB * 0x0E)) == 0;
+}
@@ -0,0 +1,128 @@
+#include "hirn_code.h"
+
+HirnCode hirn_code_pack(const PegColor* pegs, int count) {
+    HirnCode code = 0;
+    for(int i = 0; i < count; i++) {
+        code |= (uint32_t)pegs[i] << (HIRN_PEG_BITS * i);
+    }
+    return code;
+}
+
+void hirn_code_unpack(HirnCode code, PegColor* pegs, int count) {
+    for(int i = 0; i < count; i++) {
+        pegs[i] = hirn_code_get(code, i);
+    }
+}
+
+// One index conversion per shape: constant divisors become multiplies
+typedef uint16_t (*IndexKernel)(HirnCode code);
+typedef HirnCode (*FromIndexKernel)(uint16_t index);
+
+#define INDEX_KERNELS(pegs, colors)                                     \
+    static uint16_t index_##pegs##_##colors(HirnCode code) {            \
+        return hirn_code_index_of(code, pegs, colors);                  \
+    }                                                                   \
+    static HirnCode from_index_##pegs##_##colors(uint16_t index) {      \
+        return hirn_code_from_index_of(index, pegs, colors);            \
+    }
+HIRN_SHAPES(INDEX_KERNELS)
+
+#define INDEX_SLOT(pegs, colors) [HIRN_SHAPE_INDEX(pegs, colors)] = index_##pegs##_##colors,
+#define FROM_INDEX_SLOT(pegs, colors) [HIRN_SHAPE_INDEX(pegs, colors)] = from_index_##pegs##_##colors,
+static const IndexKernel index_kernels[HIRN_SHAPE_SLOTS] = {HIRN_SHAPES(INDEX_SLOT)};
+static const FromIndexKernel from_index_kernels[HIRN_SHAPE_SLOTS] = {HIRN_SHAPES(FROM_INDEX_SLOT)};
+
+uint16_t hirn_code_index(HirnCode code, HirnVariant variant) {
+    return index_kernels[HIRN_SHAPE_INDEX(variant.pegs, variant.colors)](code);
+}
+
+HirnCode hirn_code_from_index(uint16_t index, HirnVariant variant) {
+    return from_index_kernels[HIRN_SHAPE_INDEX(variant.pegs, variant.colors)](index);
+}
+
+// Permutation ranks per shape, only used without repetition
+#define RANK_KERNELS(pegs, colors)                                      \
+    static uint16_t rank_##pegs##_##colors(HirnCode code) {             \
+        return hirn_code_permutation_rank_of(code, pegs, colors);       \
+    }                                                                   \
+    static HirnCode unrank_##pegs##_##colors(uint16_t rank) {           \
+        return hirn_code_permutation_unrank_of(rank, pegs, colors);     \
+    }
+HIRN_SHAPES(RANK_KERNELS)
+
+#define RANK_SLOT(pegs, colors) [HIRN_SHAPE_INDEX(pegs, colors)] = rank_##pegs##_##colors,
+#define UNRANK_SLOT(pegs, colors) [HIRN_SHAPE_INDEX(pegs, colors)] = unrank_##pegs##_##colors,
+static const IndexKernel rank_kernels[HIRN_SHAPE_SLOTS] = {HIRN_SHAPES(RANK_SLOT)};
+static const FromIndexKernel unrank_kernels[HIRN_SHAPE_SLOTS] = {HIRN_SHAPES(UNRANK_SLOT)};
+
+uint16_t hirn_code_rank(HirnCode code, HirnVariant variant) {
+    if(variant.repeat) return hirn_code_index(code, variant);
+    return rank_kernels[HIRN_SHAPE_INDEX(variant.pegs, variant.colors)](code);
+}
+
+HirnCode hirn_code_unrank(uint16_t rank, HirnVariant variant) {
+    if(variant.repeat) return hirn_code_from_index(rank, variant);
+    return unrank_kernels[HIRN_SHAPE_INDEX(variant.pegs, variant.colors)](rank);
+}
+
+// ============================================================================
+// Feedback classes
+// ============================================================================
+
+const uint8_t hirn_feedback_black[HIRN_PEG_COUNTS][HIRN_MAX_FEEDBACK_CLASSES] = {
+    {0, 0, 0, 0, 1, 1, 1, 2, 3},  // 3 pegs
+    {0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 3, 4},  // 4 pegs
+    {0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 4, 5},  // 5 pegs
+    {0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 5, 6},  // 6 pegs
+};
+
+const uint8_t hirn_feedback_white[HIRN_PEG_COUNTS][HIRN_MAX_FEEDBACK_CLASSES] = {
+    {0, 1, 2, 3, 0, 1, 2, 0, 0},  // 3 pegs
+    {0, 1, 2, 3, 4, 0, 1, 2, 3, 0, 1, 2, 0, 0},  // 4 pegs
+    {0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 0, 1, 2, 3, 0, 1, 2, 0, 0},  // 5 pegs
+    {0, 1, 2, 3, 4, 5, 6, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 0, 1, 2, 3, 0, 1, 2, 0, 0},  // 6 pegs
+};
+
+// Indexed by black * (HIRN_MAX_PEGS + 1) + white, 0xFF marks impossible pairs
+const FeedbackClass hirn_feedback_class_table[HIRN_PEG_COUNTS][(HIRN_MAX_PEGS + 1) * (HIRN_MAX_PEGS + 1)] = {
+    {
+        // 3 pegs
+           0,    1,    2,    3, 0xFF, 0xFF, 0xFF,
+           4,    5,    6, 0xFF, 0xFF, 0xFF, 0xFF,
+           7, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+           8, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    },
+    {
+        // 4 pegs
+           0,    1,    2,    3,    4, 0xFF, 0xFF,
+           5,    6,    7,    8, 0xFF, 0xFF, 0xFF,
+           9,   10,   11, 0xFF, 0xFF, 0xFF, 0xFF,
+          12, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+          13, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    },
+    {
+        // 5 pegs
+           0,    1,    2,    3,    4,    5, 0xFF,
+           6,    7,    8,    9,   10, 0xFF, 0xFF,
+          11,   12,   13,   14, 0xFF, 0xFF, 0xFF,
+          15,   16,   17, 0xFF, 0xFF, 0xFF, 0xFF,
+          18, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+          19, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    },
+    {
+        // 6 pegs
+           0,    1,    2,    3,    4,    5,    6,
+           7,    8,    9,   10,   11,   12, 0xFF,
+          13,   14,   15,   16,   17, 0xFF, 0xFF,
+          18,   19,   20,   21, 0xFF, 0xFF, 0xFF,
+          22,   23,   24, 0xFF, 0xFF, 0xFF, 0xFF,
+          25, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+          26, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    },
+};
@@ -0,0 +1,294 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// ============================================================================
+// Game variants: pegs per code, colors to choose from, and whether colors
+// can repeat in the secret, chosen at runtime. Code indices are 16 bits,
+// which leaves out 6 pegs of 7 or 8 colors.
+// ============================================================================
+
+#define HIRN_MIN_PEGS 3
+#define HIRN_MAX_PEGS 6
+#define HIRN_MIN_COLORS 4
+#define HIRN_MAX_COLORS 8
+#define HIRN_MAX_CODE_SPACE 46656  // 6 pegs of 6 colors, the largest variant with 16-bit indices
+
+typedef struct {
+    uint8_t pegs;    // Number of pegs in the code
+    uint8_t colors;  // Number of available colors
+    bool repeat;     // Whether colors can repeat in the secret code
+} HirnVariant;
+
+// The classic game, and the one the app starts with
+#define HIRN_VARIANT_CLASSIC ((HirnVariant){.pegs = 4, .colors = 6, .repeat = false})
+
+// Every (pegs, colors) shape within 16-bit indices. Each gets its own
+// unrolled kernels, see hirn_candidates.c and hirn_solver.c.
+#define HIRN_SHAPES(X) \
+    X(3, 4) X(3, 5) X(3, 6) X(3, 7) X(3, 8) \
+    X(4, 4) X(4, 5) X(4, 6) X(4, 7) X(4, 8) \
+    X(5, 4) X(5, 5) X(5, 6) X(5, 7) X(5, 8) \
+    X(6, 4) X(6, 5) X(6, 6)
+
+// Slot of a shape in the kernel tables
+#define HIRN_SHAPE_INDEX(pegs, colors) \
+    (((pegs) - HIRN_MIN_PEGS) * (HIRN_MAX_COLORS - HIRN_MIN_COLORS + 1) + (colors) - HIRN_MIN_COLORS)
+#define HIRN_SHAPE_SLOTS (HIRN_SHAPE_INDEX(HIRN_MAX_PEGS, HIRN_MAX_COLORS) + 1)
+
+// Number of codes with repetition; code indices run from 0 to this - 1
+static inline uint32_t hirn_code_space(HirnVariant variant) {
+    uint32_t space = 1;
+    for(int i = 0; i < variant.pegs; i++) {
+        space *= variant.colors;
+    }
+    return space;
+}
+
+// Within the limits above, and enough colors for a secret without repetition
+static inline bool hirn_variant_valid(HirnVariant variant) {
+    return variant.pegs >= HIRN_MIN_PEGS && variant.pegs <= HIRN_MAX_PEGS &&
+           variant.colors >= HIRN_MIN_COLORS && variant.colors <= HIRN_MAX_COLORS &&
+           hirn_code_space(variant) <= HIRN_MAX_CODE_SPACE && (variant.repeat || variant.colors >= variant.pegs);
+}
+
+static inline bool hirn_variant_equal(HirnVariant a, HirnVariant b) {
+    return a.pegs == b.pegs && a.colors == b.colors && a.repeat == b.repeat;
+}
+
+// Color patterns (fill styles)
+typedef enum {
+    COLOR_NONE = 0,  // Empty/unfilled
+    COLOR_RED,       // Solid fill
+    COLOR_GREEN,     // Horizontal lines
+    COLOR_BLUE,      // Vertical lines
+    COLOR_YELLOW,    // Diagonal lines (/)
+    COLOR_PURPLE,    // Diagonal lines (\)
+    COLOR_ORANGE,    // Cross-hatch
+    COLOR_CYAN,      // Dots
+    COLOR_PINK       // Ring
+} PegColor;
+
+// Feedback of one attempt as a dense (black, white) class index, see below
+typedef uint8_t FeedbackClass;
+
+// ============================================================================
+// Packed codes and the scoring kernel.
+// A code is one 32-bit word with one nibble per peg (peg 0 in the lowest
+// nibble, COLOR_NONE = 0, unused pegs 0). Scoring is branch-free SWAR on
+// these words. The inline kernels take the peg count as an argument; called
+// with a constant they unroll into the code of a fixed-size variant.
+// ============================================================================
+
+typedef uint32_t HirnCode;
+
+// Feedback of one guess: black count in the high nibble, white in the low one
+typedef uint8_t HirnScore;
+
+#define HIRN_PEG_BITS 4
+#define HIRN_NIBBLE_LSB 0x11111111u
+
+// Color counts live in nibbles too and must stay below 8 for hirn_nibble_min
+_Static_assert(HIRN_MAX_PEGS <= 7, "per-color counts must fit in 3 bits");
+_Static_assert(HIRN_MAX_COLORS <= 8, "one count nibble per color");
+
+#define HIRN_SCORE(black, white) ((HirnScore)(((black) << 4) | (white)))
+
+static inline uint8_t hirn_score_black(HirnScore score) {
+    return score >> 4;
+}
+
+static inline uint8_t hirn_score_white(HirnScore score) {
+    return score & 0x0F;
+}
+
+// The nibbles of the first pegs pegs
+static inline uint32_t hirn_code_mask(int pegs) {
+    return (uint32_t)((1ull << (HIRN_PEG_BITS * pegs)) - 1);
+}
+
+static inline PegColor hirn_code_get(HirnCode code, int peg) {
+    return (PegColor)((code >> (HIRN_PEG_BITS * peg)) & 0x0F);
+}
+
+static inline HirnCode hirn_code_set(HirnCode code, int peg, PegColor color) {
+    uint32_t shift = HIRN_PEG_BITS * peg;
+    return (code & ~(0x0Fu << shift)) | ((uint32_t)color << shift);
+}
+
+HirnCode hirn_code_pack(const PegColor* pegs, int count);
+void hirn_code_unpack(HirnCode code, PegColor* pegs, int count);
+
+// Mixed-radix index of a complete code: sum of (color_i - 1) * colors^i
+static inline uint16_t hirn_code_index_of(HirnCode code, int pegs, int colors) {
+    uint32_t index = 0;
+#pragma GCC unroll 8
+    for(int i = pegs - 1; i >= 0; i--) {
+        index = index * colors + hirn_code_get(code, i) - 1;
+    }
+    return index;
+}
+
+static inline HirnCode hirn_code_from_index_of(uint16_t index, int pegs, int colors) {
+    HirnCode code = 0;
+    uint32_t rest = index;
+#pragma GCC unroll 8
+    for(int i = 0; i < pegs; i++) {
+        code |= (rest % colors + 1) << (HIRN_PEG_BITS * i);
+        rest /= colors;
+    }
+    return code;
+}
+
+uint16_t hirn_code_index(HirnCode code, HirnVariant variant);
+HirnCode hirn_code_from_index(uint16_t index, HirnVariant variant);
+
+// ============================================================================
+// Dense ranks: every possible secret of a variant maps to 0..rank space - 1.
+// With repetition the rank is the mixed-radix index. Without it, the rank of
+// a repetition-free code counts in the falling factorial base: peg pegs - 1
+// picks one of colors, the next one of the colors - 1 left, and so on. Both
+// keep the order of code indices, so ranks enumerate secrets in index order.
+// ============================================================================
+
+// Number of possible secrets: colors^pegs, or colors! / (colors - pegs)! without repetition
+static inline uint32_t hirn_code_rank_space(HirnVariant variant) {
+    if(variant.repeat) return hirn_code_space(variant);
+    uint32_t space = 1;
+    for(int i = 0; i < variant.pegs; i++) {
+        space *= variant.colors - i;
+    }
+    return space;
+}
+
+// Rank of a complete repetition-free code
+static inline uint16_t hirn_code_permutation_rank_of(HirnCode code, int pegs, int colors) {
+    uint32_t rank = 0;
+    uint32_t used = 0;  // Bit c - 1 set once color c is taken
+#pragma GCC unroll 8
+    for(int i = pegs - 1; i >= 0; i--) {
+        uint32_t color = hirn_code_get(code, i) - 1;
+        // Digit: colors still free that sort below this one
+        uint32_t digit = color - __builtin_popcount(used & ((1u << color) - 1));
+        rank = rank * (colors - (pegs - 1 - i)) + digit;
+        used |= 1u << color;
+    }
+    return rank;
+}
+
+static inline HirnCode hirn_code_permutation_unrank_of(uint16_t rank, int pegs, int colors) {
+    uint32_t digits[HIRN_MAX_PEGS];
+    uint32_t rest = rank;
+#pragma GCC unroll 8
+    for(int i = 0; i < pegs; i++) {
+        uint32_t radix = colors - (pegs - 1 - i);
+        digits[i] = rest % radix;
+        rest /= radix;
+    }
+    HirnCode code = 0;
+    uint32_t free = (1u << colors) - 1;
+#pragma GCC unroll 8
+    for(int i = pegs - 1; i >= 0; i--) {
+        // The digit-th free color: drop the lower free bits, take the lowest left
+        uint32_t candidates = free;
+        for(uint32_t skip = digits[i]; skip; skip--) {
+            candidates &= candidates - 1;
+        }
+        uint32_t color = __builtin_ctz(candidates);
+        free &= ~(1u << color);
+        code |= (color + 1) << (HIRN_PEG_BITS * i);
+    }
+    return code;
+}
+
+// Rank of a possible secret of variant (repetition-free unless it repeats)
+uint16_t hirn_code_rank(HirnCode code, HirnVariant variant);
+HirnCode hirn_code_unrank(uint16_t rank, HirnVariant variant);
+
+// True if none of the pegs is COLOR_NONE
+static inline bool hirn_code_is_complete(HirnCode code, int pegs) {
+    uint32_t set = code | code >> 2;
+    set |= set >> 1;  // Bit 0 of each nibble is set iff the peg has a color
+    uint32_t lsb = HIRN_NIBBLE_LSB & hirn_code_mask(pegs);
+    return (set & lsb) == lsb;
+}
+
+// Sum of all nibbles, valid while the total stays below 16
+static inline uint32_t hirn_nibble_sum(uint32_t x) {
+    return (x * HIRN_NIBBLE_LSB) >> 28;
+}
+
+// Per-nibble minimum of two vectors holding values 0..7
+static inline uint32_t hirn_nibble_min(uint32_t a, uint32_t b) {
+    // (a + 8) - b never borrows across nibbles, bit 3 survives iff a >= b
+    uint32_t ge = (((a | (HIRN_NIBBLE_LSB << 3)) - b) >> 3) & HIRN_NIBBLE_LSB;
+    uint32_t mask = ge * 0x0Fu;
+    return (b & mask) | (a & ~mask);
+}
+
+// Color histogram: nibble c - 1 counts the pegs of color c, COLOR_NONE is ignored
+static inline uint32_t hirn_code_histogram(HirnCode code, int pegs) {
+    uint32_t histogram = 0;
+#pragma GCC unroll 8
+    for(int i = 0; i < pegs; i++) {
+        uint32_t color = (code >> (HIRN_PEG_BITS * i)) & 0x0F;
+        histogram += (uint32_t)(color != 0) << (HIRN_PEG_BITS * ((color - 1) & 7));
+    }
+    return histogram;
+}
+
+// Number of pegs with the same color at the same position
+static inline uint32_t hirn_code_black(HirnCode a, HirnCode b, int pegs) {
+    uint32_t diff = a ^ b;
+    diff |= diff >> 2;
+    diff |= diff >> 1;  // Bit 0 of each nibble is set iff the nibble differs
+    return pegs - hirn_nibble_sum(diff & HIRN_NIBBLE_LSB & hirn_code_mask(pegs));
+}
+
+// Score with precomputed histograms, for callers that score one code many times
+static inline HirnScore hirn_score_histograms(
+    HirnCode secret, uint32_t secret_histogram, HirnCode guess, uint32_t guess_histogram, int pegs) {
+    uint32_t black = hirn_code_black(secret, guess, pegs);
+    uint32_t matches = hirn_nibble_sum(hirn_nibble_min(secret_histogram, guess_histogram));
+    return HIRN_SCORE(black, matches - black);
+}
+
+// Black and white pegs for a complete guess against a complete secret
+static inline HirnScore hirn_score(HirnCode secret, HirnCode guess, int pegs) {
+    return hirn_score_histograms(
+        secret, hirn_code_histogram(secret, pegs), guess, hirn_code_histogram(guess, pegs), pegs);
+}
+
+// ============================================================================
+// Feedback classes.
+// Each valid (black, white) pair gets a dense index, ordered by black then
+// white: 0..13 for 4 pegs, as (pegs - 1, 1) can't happen. One table row per
+// peg count.
+// ============================================================================
+
+#define HIRN_FEEDBACK_CLASSES(pegs) (((pegs) + 1) * ((pegs) + 2) / 2 - 1)
+#define HIRN_FEEDBACK_WIN(pegs) (HIRN_FEEDBACK_CLASSES(pegs) - 1)  // All pegs black
+#define HIRN_MAX_FEEDBACK_CLASSES HIRN_FEEDBACK_CLASSES(HIRN_MAX_PEGS)
+#define HIRN_PEG_COUNTS (HIRN_MAX_PEGS - HIRN_MIN_PEGS + 1)
+
+extern const uint8_t hirn_feedback_black[HIRN_PEG_COUNTS][HIRN_MAX_FEEDBACK_CLASSES];
+extern const uint8_t hirn_feedback_white[HIRN_PEG_COUNTS][HIRN_MAX_FEEDBACK_CLASSES];
+extern const FeedbackClass hirn_feedback_class_table[HIRN_PEG_COUNTS][(HIRN_MAX_PEGS + 1) * (HIRN_MAX_PEGS + 1)];
+
+static inline FeedbackClass hirn_feedback_class(HirnScore score, int pegs) {
+    return hirn_feedback_class_table[pegs - HIRN_MIN_PEGS]
+                                    [hirn_score_black(score) * (HIRN_MAX_PEGS + 1) + hirn_score_white(score)];
+}
+
+static inline uint8_t hirn_feedback_blacks(FeedbackClass feedback, int pegs) {
+    return hirn_feedback_black[pegs - HIRN_MIN_PEGS][feedback];
+}
+
+static inline uint8_t hirn_feedback_whites(FeedbackClass feedback, int pegs) {
+    return hirn_feedback_white[pegs - HIRN_MIN_PEGS][feedback];
+}
+
+static inline HirnScore hirn_feedback_score(FeedbackClass feedback, int pegs) {
+    return HIRN_SCORE(hirn_feedback_blacks(feedback, pegs), hirn_feedback_whites(feedback, pegs));
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <stdint.h>
+
+// ============================================================================
+// SIMD8 instructions of the Cortex-M4 DSP extension: four unsigned byte lanes
+// per word. On the Flipper these are the ACLE intrinsics, anywhere else a
+// portable emulation, so the host runs the same code.
+// ============================================================================
+
+#if defined(__ARM_FEATURE_SIMD32)
+
+#include <arm_acle.h>
+
+#define hirn_uqsub8 __uqsub8
+
+#else
+
+// Per-lane a - b, saturated at 0
+static inline uint32_t hirn_uqsub8(uint32_t a, uint32_t b) {
+    uint32_t result = 0;
+    for(int lane = 0; lane < 4; lane++) {
+        uint32_t x = (a >> (8 * lane)) & 0xFF;
+        uint32_t y = (b >> (8 * lane)) & 0xFF;
+        result |= (x > y ? x - y : 0) << (8 * lane);
+    }
+    return result;
+}
+
+#endif
+
+#define HIRN_LANE_LSB 0x01010101u
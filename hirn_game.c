@@ -0,0 +1,209 @@
+#include "hirn_game.h"
+
+#include <furi.h>          // Ticks and logging (host/furi.h on Linux)
+#include "hirn_random.h"   // Seedable PRNG
+#include "hirn_profile.h"  // Optional timing, see HIRN_PROFILE
+
+#define TAG "Hirn"  // Tag for logging
+
+static HirnRandom game_random;  // Source of the secret codes, see seed_game_random
+
+// ============================================================================
+// Game Logic Functions
+// ============================================================================
+
+void seed_game_random(uint64_t seed) {
+    hirn_random_seed(&game_random, seed);
+}
+
+// Generate random secret code
+void generate_secret_code(CodeBreakerState* state) {
+    HIRN_PROFILE_START(profile);
+    HirnVariant variant = state->variant;
+    FURI_LOG_I(TAG, "Generating secret code (pegs=%d, colors=%d, repeat=%d)",
+               variant.pegs, variant.colors, variant.repeat);
+
+    // Fixed number of draws, no rejection loop over used colors
+    HirnCode code = hirn_random_code(&game_random, variant);
+    state->secret_code = code;
+    FURI_LOG_I(TAG, "Secret code: %06lx", (unsigned long)code);
+    HIRN_PROFILE_STOP(HirnProfileGenerateSecret, profile);
+}
+
+// Check if all pegs in current guess have been selected
+bool is_guess_complete(const CodeBreakerState* state) {
+    return hirn_code_is_complete(state->current_guess, state->variant.pegs);
+}
+
+void reset_game_state(CodeBreakerState* state, HirnVariant variant) {
+    state->variant = variant;
+    state->state = STATE_PLAYING;
+    state->cursor_position = 0;
+    state->attempts_used = 0;
+    state->start_time = furi_get_tick();
+    state->elapsed_time = 0;
+    state->current_guess = 0;  // All pegs COLOR_NONE
+
+    generate_secret_code(state);
+}
+
+// Check if current guess is different from previous guess
+bool is_guess_different(const CodeBreakerState* state) {
+    if(state->attempts_used == 0) {
+        return true;  // First guess is always different
+    }
+    return state->current_guess !=
+           hirn_code_from_index(state->guess_history[state->attempts_used - 1], state->variant);
+}
+
+// Evaluate the current guess and provide feedback
+void evaluate_guess(CodeBreakerState* state) {
+    HIRN_PROFILE_START(profile);
+    HirnCode guess = state->current_guess;
+    HirnVariant variant = state->variant;
+    FURI_LOG_I(TAG, "Evaluating guess #%d: %06lx", state->attempts_used + 1, (unsigned long)guess);
+
+    HirnScore score = hirn_score(state->secret_code, guess, variant.pegs);
+    state->feedback_history[state->attempts_used] = hirn_feedback_class(score, variant.pegs);
+
+    FURI_LOG_D(TAG, "Feedback: Black=%d, White=%d", hirn_score_black(score), hirn_score_white(score));
+
+    // Check for win condition (all black pegs)
+    bool won = hirn_score_black(score) == variant.pegs;
+
+    // Save guess to history
+    state->guess_history[state->attempts_used] = hirn_code_index(guess, variant);
+
+    state->attempts_used++;
+
+    if(won) {
+        state->state = STATE_WON;
+        state->elapsed_time += furi_get_tick() - state->start_time;
+        FURI_LOG_I(TAG, "Game won! Attempts: %d, Time: %lu ms",
+                   state->attempts_used, state->elapsed_time);
+    } else if(state->attempts_used >= MAX_ATTEMPTS) {
+        state->state = STATE_LOST;
+        state->elapsed_time += furi_get_tick() - state->start_time;
+        FURI_LOG_I(TAG, "Game lost! Max attempts reached.");
+    }
+    // Don't reset guess - keep previous colors for next attempt
+    HIRN_PROFILE_STOP(HirnProfileEvaluateGuess, profile);
+}
+
+// Unrolled for each shape of HIRN_SHAPES, like the candidate filter
+static inline __attribute__((always_inline)) int conflict_kernel(
+    const CodeBreakerState* state, int pegs, int colors) {
+    HirnCode guess = state->current_guess;
+    uint32_t guess_histogram = hirn_code_histogram(guess, pegs);
+    int empty = pegs - hirn_nibble_sum(guess_histogram);
+
+    for(int i = 0; i < state->attempts_used; i++) {
+        // Score the past guess against the current one as if it were the secret,
+        // empty pegs match nothing
+        HirnCode past = hirn_code_from_index_of(state->guess_history[i], pegs, colors);
+        HirnScore score =
+            hirn_score_histograms(guess, guess_histogram, past, hirn_code_histogram(past, pegs), pegs);
+        HirnScore feedback = hirn_feedback_score(state->feedback_history[i], pegs);
+        int black = hirn_score_black(score);
+        int matches = black + hirn_score_white(score);
+        int wanted_black = hirn_score_black(feedback);
+        int wanted_matches = wanted_black + hirn_score_white(feedback);
+        // Filling the empty pegs can only add blacks and matches, one per peg
+        if(black > wanted_black || black + empty < wanted_black ||
+           matches > wanted_matches || matches + empty < wanted_matches) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+typedef int (*ConflictKernel)(const CodeBreakerState* state);
+
+#define CONFLICT_KERNEL(pegs, colors)                                      \
+    static int conflict_##pegs##_##colors(const CodeBreakerState* state) { \
+        return conflict_kernel(state, pegs, colors);                       \
+    }
+HIRN_SHAPES(CONFLICT_KERNEL)
+
+#define CONFLICT_SLOT(pegs, colors) [HIRN_SHAPE_INDEX(pegs, colors)] = conflict_##pegs##_##colors,
+static const ConflictKernel conflict_kernels[HIRN_SHAPE_SLOTS] = {HIRN_SHAPES(CONFLICT_SLOT)};
+
+int find_conflicting_attempt(const CodeBreakerState* state) {
+    return conflict_kernels[HIRN_SHAPE_INDEX(state->variant.pegs, state->variant.colors)](state);
+}
+
+// ============================================================================
+// State Transitions
+// ============================================================================
+
+uint32_t get_total_time(const CodeBreakerState* state) {
+    uint32_t total_time;
+    if(state->state == STATE_PLAYING) {
+        total_time = state->elapsed_time + (furi_get_tick() - state->start_time);
+    } else {
+        total_time = state->elapsed_time;
+    }
+    if(total_time > MAX_TIME_MS) total_time = MAX_TIME_MS;
+    return total_time;
+}
+
+void pause_game(CodeBreakerState* state) {
+    if(state->state != STATE_PLAYING) return;
+    FURI_LOG_I(TAG, "Game paused");
+    state->state = STATE_PAUSED;
+    state->elapsed_time += furi_get_tick() - state->start_time;
+}
+
+void resume_game(CodeBreakerState* state) {
+    if(state->state != STATE_PAUSED && state->state != STATE_REVEAL) return;
+    FURI_LOG_I(TAG, "Game resumed");
+    state->state = STATE_PLAYING;
+    state->start_time = furi_get_tick();
+}
+
+void toggle_reveal(CodeBreakerState* state) {
+    if(state->state == STATE_PLAYING) {
+        FURI_LOG_W(TAG, "Secret code revealed by user");
+        state->elapsed_time += furi_get_tick() - state->start_time;
+        state->state = STATE_REVEAL;
+    } else if(state->state == STATE_REVEAL) {
+        FURI_LOG_I(TAG, "Hiding secret code");
+        state->state = STATE_PLAYING;
+        state->start_time = furi_get_tick();
+    }
+}
+
+void move_cursor(CodeBreakerState* state, int delta) {
+    int position = state->cursor_position + delta;
+    if(position < 0) position = 0;
+    if(position > state->variant.pegs - 1) position = state->variant.pegs - 1;
+    if(position != state->cursor_position) {
+        state->cursor_position = position;
+        FURI_LOG_D(TAG, "Cursor moved to position %d", state->cursor_position);
+    }
+}
+
+void set_current_guess(CodeBreakerState* state, HirnCode guess) {
+    state->current_guess = guess & hirn_code_mask(state->variant.pegs);
+    FURI_LOG_D(TAG, "Guess set to %06lx", (unsigned long)state->current_guess);
+}
+
+void cycle_color(CodeBreakerState* state, int delta) {
+    // COLOR_NONE plus the variant's colors form one ring
+    int ring = state->variant.colors + 1;
+    // PegColor is unsigned, stepping down from COLOR_NONE must stay signed
+    int current = ((int)hirn_code_get(state->current_guess, state->cursor_position) + delta) % ring;
+    if(current < COLOR_NONE) current += ring;
+    state->current_guess = hirn_code_set(state->current_guess, state->cursor_position, current);
+    FURI_LOG_D(TAG, "Color changed to %d at position %d", current, state->cursor_position);
+}
+
+bool check_time_limit(CodeBreakerState* state) {
+    if(state->state != STATE_PLAYING) return false;
+    uint32_t current_time = state->elapsed_time + (furi_get_tick() - state->start_time);
+    if(current_time < MAX_TIME_MS) return false;
+    FURI_LOG_W(TAG, "Time limit reached - game lost");
+    state->state = STATE_LOST;
+    state->elapsed_time = MAX_TIME_MS;
+    return true;
+}
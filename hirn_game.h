@@ -0,0 +1,104 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "hirn_code.h"
+
+// ============================================================================
+// Game core: state, scoring, RNG and state transitions.
+// Only depends on furi.h for ticks and logging, see host/ for the Linux build.
+// ============================================================================
+
+#define MAX_ATTEMPTS 20     // Maximum number of guessing attempts
+#define MAX_TIME_MS (20 * 60 * 1000)  // Maximum time in milliseconds
+
+// ============================================================================
+// Enumerations
+// ============================================================================
+
+// Game states
+typedef enum {
+    STATE_PLAYING,
+    STATE_PAUSED,
+    STATE_WON,
+    STATE_LOST,
+    STATE_REVEAL
+} GameState;
+
+// ============================================================================
+// Data Structures
+// ============================================================================
+
+// Application state, kept compact since the FAP shares scarce RAM with other apps
+typedef struct {
+    uint32_t start_time;
+    uint32_t elapsed_time;
+    HirnCode secret_code;    // Packed pegs, see hirn_code.h
+    HirnCode current_guess;  // Packed pegs, COLOR_NONE where not chosen yet
+    HirnVariant variant;     // Pegs, colors and repetition of this round
+
+    // History of previous guesses (as code indices) and feedback
+    uint16_t guess_history[MAX_ATTEMPTS];
+    FeedbackClass feedback_history[MAX_ATTEMPTS];
+
+    uint8_t state;  // GameState
+    uint8_t cursor_position;
+    uint8_t attempts_used;
+} CodeBreakerState;
+
+// 80 bytes with a fixed variant; the runtime one adds 3 bytes, padded to 84.
+// The fields themselves take 82 bytes, no order gets back under 84.
+_Static_assert(sizeof(CodeBreakerState) <= 84, "CodeBreakerState outgrew its RAM budget");
+
+// ============================================================================
+// Game Logic Functions
+// ============================================================================
+
+// Seed the generator behind generate_secret_code, same seed gives the same secrets
+void seed_game_random(uint64_t seed);
+
+// Generate random secret code
+void generate_secret_code(CodeBreakerState* state);
+
+// Check if all pegs in current guess have been selected
+bool is_guess_complete(const CodeBreakerState* state);
+
+// Check if current guess is different from previous guess
+bool is_guess_different(const CodeBreakerState* state);
+
+// Start a new round of variant with a fresh secret code
+void reset_game_state(CodeBreakerState* state, HirnVariant variant);
+
+// Evaluate the current guess, record it and its feedback in the history
+void evaluate_guess(CodeBreakerState* state);
+
+// First past attempt (0-based) whose feedback the current guess contradicts, or -1.
+// A complete guess conflicts iff it couldn't be the secret; for a partial one
+// this is a necessary condition only: no choice of the empty pegs can help.
+int find_conflicting_attempt(const CodeBreakerState* state);
+
+// ============================================================================
+// State Transitions
+// ============================================================================
+
+// Play time so far, including the running segment while playing
+uint32_t get_total_time(const CodeBreakerState* state);
+
+void pause_game(CodeBreakerState* state);
+void resume_game(CodeBreakerState* state);
+
+// Show (while playing) or hide (while revealed) the secret code
+void toggle_reveal(CodeBreakerState* state);
+
+// Move the cursor by delta pegs, clamped to the code
+void move_cursor(CodeBreakerState* state, int delta);
+
+// Replace the whole current guess, e.g. with a hint
+void set_current_guess(CodeBreakerState* state, HirnCode guess);
+
+// Step the color under the cursor by delta, wrapping through COLOR_NONE
+void cycle_color(CodeBreakerState* state, int delta);
+
+// Returns true if the time limit was hit and the game is now lost
+bool check_time_limit(CodeBreakerState* state);
@@ -0,0 +1,188 @@
+#include "hirn_partition.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "hirn_dsp.h"
+
+// ============================================================================
+// Kernels. The scalar one scores one code per step from its code and color
+// histogram, set->words holds the codes and then their histograms.
+//
+// The SIMD one scores four codes per step, one per byte lane. set->words
+// holds a group of pegs + colors words per four codes: first the color of
+// each peg, then the count of each color, code 4 * group + lane in byte
+// lane. A peg is black where 1 - min(color difference, 1) is 1, and the
+// matches are the pegs less how far each color count exceeds the guess's,
+// both one saturating lane subtraction per peg or color and plain adds.
+// ============================================================================
+
+typedef uint16_t (*PartitionKernel)(
+    const uint32_t* words, uint16_t count, HirnCode guess, uint16_t* partitions, uint32_t limit);
+
+static inline __attribute__((always_inline)) uint16_t scalar_kernel(
+    const uint32_t* words,
+    uint16_t count,
+    HirnCode guess,
+    uint16_t* partitions,
+    uint32_t limit,
+    int pegs) {
+    const HirnCode* codes = words;
+    const uint32_t* histograms = words + count;
+    uint32_t guess_histogram = hirn_code_histogram(guess, pegs);
+    uint16_t worst = 0;
+    for(uint16_t i = 0; i < count; i++) {
+        HirnScore score = hirn_score_histograms(codes[i], histograms[i], guess, guess_histogram, pegs);
+        uint16_t size = ++partitions[hirn_feedback_class(score, pegs)];
+        if(size > worst) {
+            worst = size;
+            if(worst >= limit) break;
+        }
+    }
+    return worst;
+}
+
+static inline __attribute__((always_inline)) uint16_t simd_kernel(
+    const uint32_t* words,
+    uint16_t count,
+    HirnCode guess,
+    uint16_t* partitions,
+    uint32_t limit,
+    int pegs,
+    int colors) {
+    // The guess's peg colors and color counts, each repeated in every lane
+    uint32_t guess_pegs[HIRN_MAX_PEGS];
+    uint32_t guess_counts[HIRN_MAX_COLORS];
+    uint32_t guess_histogram = hirn_code_histogram(guess, pegs);
+    for(int peg = 0; peg < pegs; peg++) {
+        guess_pegs[peg] = hirn_code_get(guess, peg) * HIRN_LANE_LSB;
+    }
+    for(int color = 0; color < colors; color++) {
+        guess_counts[color] = ((guess_histogram >> (HIRN_PEG_BITS * color)) & 0x0F) * HIRN_LANE_LSB;
+    }
+    const FeedbackClass* classes = hirn_feedback_class_table[pegs - HIRN_MIN_PEGS];
+
+    uint16_t worst = 0;
+    for(uint16_t first = 0; first < count; first += 4) {
+        const uint32_t* group = words + first / 4 * (pegs + colors);
+        uint32_t black = 0;
+#pragma GCC unroll 8
+        for(int peg = 0; peg < pegs; peg++) {
+            black += hirn_uqsub8(HIRN_LANE_LSB, group[peg] ^ guess_pegs[peg]);
+        }
+        uint32_t excess = 0;
+#pragma GCC unroll 8
+        for(int color = 0; color < colors; color++) {
+            excess += hirn_uqsub8(group[pegs + color], guess_counts[color]);
+        }
+        // Per lane black * (HIRN_MAX_PEGS + 1) + white, at most 42: no carries
+        uint32_t slots = black * HIRN_MAX_PEGS + pegs * HIRN_LANE_LSB - excess;
+        // In code order, so counting stops where the scalar kernel stops
+        int lanes = count - first < 4 ? count - first : 4;
+        for(int lane = 0; lane < lanes; lane++) {
+            uint16_t size = ++partitions[classes[(slots >> (8 * lane)) & 0xFF]];
+            if(size > worst) {
+                worst = size;
+                if(worst >= limit) return worst;
+            }
+        }
+    }
+    return worst;
+}
+
+// Scalar kernels per peg count, the histograms take care of the colors
+#define SCALAR_KERNEL(pegs)                                                                           \
+    static uint16_t scalar_##pegs(                                                                    \
+        const uint32_t* words, uint16_t count, HirnCode guess, uint16_t* partitions, uint32_t limit) { \
+        return scalar_kernel(words, count, guess, partitions, limit, pegs);                           \
+    }
+SCALAR_KERNEL(3)
+SCALAR_KERNEL(4)
+SCALAR_KERNEL(5)
+SCALAR_KERNEL(6)
+
+static const PartitionKernel scalar_kernels[HIRN_PEG_COUNTS] = {scalar_3, scalar_4, scalar_5, scalar_6};
+
+// SIMD kernels per shape of HIRN_SHAPES
+#define SIMD_KERNEL(pegs, colors)                                                                     \
+    static uint16_t simd_##pegs##_##colors(                                                           \
+        const uint32_t* words, uint16_t count, HirnCode guess, uint16_t* partitions, uint32_t limit) { \
+        return simd_kernel(words, count, guess, partitions, limit, pegs, colors);                     \
+    }
+HIRN_SHAPES(SIMD_KERNEL)
+
+#define SIMD_SLOT(pegs, colors) [HIRN_SHAPE_INDEX(pegs, colors)] = simd_##pegs##_##colors,
+static const PartitionKernel simd_kernels[HIRN_SHAPE_SLOTS] = {HIRN_SHAPES(SIMD_SLOT)};
+
+// ============================================================================
+// Partition Set
+// ============================================================================
+
+void hirn_partition_set_fill(
+    HirnPartitionSet* set,
+    const uint16_t* indices,
+    uint16_t count,
+    HirnVariant variant,
+    HirnPartitionMethod method) {
+    free(set->words);
+    set->variant = variant;
+    set->method = method;
+    set->count = count;
+    int pegs = variant.pegs;
+
+    if(method == HirnPartitionScalar) {
+        set->words = malloc(2 * count * sizeof(uint32_t));
+        for(uint16_t i = 0; i < count; i++) {
+            HirnCode code = hirn_code_from_index(indices[i], variant);
+            set->words[i] = code;
+            set->words[count + i] = hirn_code_histogram(code, pegs);
+        }
+        return;
+    }
+
+    // Lanes past the last code stay 0, the kernel doesn't count them
+    uint32_t stride = pegs + variant.colors;
+    size_t size = (count + 3) / 4 * stride * sizeof(uint32_t);
+    set->words = malloc(size);
+    memset(set->words, 0, size);
+    for(uint16_t i = 0; i < count; i++) {
+        uint32_t* group = set->words + i / 4 * stride;
+        int shift = 8 * (i % 4);
+        HirnCode code = hirn_code_from_index(indices[i], variant);
+        uint32_t histogram = hirn_code_histogram(code, pegs);
+        for(int peg = 0; peg < pegs; peg++) {
+            group[peg] |= (uint32_t)hirn_code_get(code, peg) << shift;
+        }
+        for(int color = 0; color < variant.colors; color++) {
+            group[pegs + color] |= ((histogram >> (HIRN_PEG_BITS * color)) & 0x0F) << shift;
+        }
+    }
+}
+
+void hirn_partition_set_free(HirnPartitionSet* set) {
+    free(set->words);
+    set->words = NULL;
+    set->count = 0;
+}
+
+// ============================================================================
+// Partition Histogram
+// ============================================================================
+
+static uint16_t partition(const HirnPartitionSet* set, HirnCode guess, uint16_t* partitions, uint32_t limit) {
+    HirnVariant variant = set->variant;
+    memset(partitions, 0, HIRN_FEEDBACK_CLASSES(variant.pegs) * sizeof(uint16_t));
+    PartitionKernel kernel = set->method == HirnPartitionScalar ?
+                                 scalar_kernels[variant.pegs - HIRN_MIN_PEGS] :
+                                 simd_kernels[HIRN_SHAPE_INDEX(variant.pegs, variant.colors)];
+    return kernel(set->words, set->count, guess, partitions, limit);
+}
+
+void hirn_partition_histogram(const HirnPartitionSet* set, HirnCode guess, uint16_t* partitions) {
+    partition(set, guess, partitions, UINT32_MAX);
+}
+
+uint16_t hirn_partition_worst(const HirnPartitionSet* set, HirnCode guess, uint32_t limit) {
+    uint16_t partitions[HIRN_MAX_FEEDBACK_CLASSES];
+    return partition(set, guess, partitions, limit);
+}
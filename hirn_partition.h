@@ -0,0 +1,50 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "hirn_code.h"
+
+// ============================================================================
+// Partition histogram: how many codes of a set fall into each feedback class
+// of one guess, the primitive behind every guess-rating strategy. The set is
+// unpacked once for its method and then scored against many guesses; both
+// methods give the same counts.
+// ============================================================================
+
+typedef enum {
+    HirnPartitionScalar,  // One code per step, nibble SWAR scoring, see hirn_code.h
+    HirnPartitionSimd,    // Four codes per step in byte lanes, see hirn_dsp.h
+} HirnPartitionMethod;
+
+// The method the target runs best: the DSP extension where there is one
+#if defined(__ARM_FEATURE_SIMD32)
+#define HIRN_PARTITION_NATIVE HirnPartitionSimd
+#else
+#define HIRN_PARTITION_NATIVE HirnPartitionScalar
+#endif
+
+// Codes unpacked for one method. Zeroed memory is an empty set.
+typedef struct {
+    HirnVariant variant;
+    HirnPartitionMethod method;
+    uint16_t count;
+    uint32_t* words;  // Layout per method, see hirn_partition.c
+} HirnPartitionSet;
+
+// Unpack count code indices of variant, replacing what set held
+void hirn_partition_set_fill(
+    HirnPartitionSet* set,
+    const uint16_t* indices,
+    uint16_t count,
+    HirnVariant variant,
+    HirnPartitionMethod method);
+
+void hirn_partition_set_free(HirnPartitionSet* set);
+
+// Fill partitions[0..HIRN_FEEDBACK_CLASSES(pegs) - 1] with the number of
+// codes of set guess scores as each class
+void hirn_partition_histogram(const HirnPartitionSet* set, HirnCode guess, uint16_t* partitions);
+
+// Size of the largest partition guess splits set into. Counting stops once a
+// partition reaches limit, the result is then limit or more.
+uint16_t hirn_partition_worst(const HirnPartitionSet* set, HirnCode guess, uint32_t limit);
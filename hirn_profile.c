@@ -0,0 +1,99 @@
+#include "hirn_profile.h"
+
+#if defined(HIRN_PROFILE) || defined(HIRN_DEBUG_OVERLAY)
+
+#include <furi.h>
+#include <string.h>
+
+#ifdef HIRN_HOST
+#include <time.h>
+#define UNIT "ns"
+#else
+#include <furi_hal.h>  // DWT, enabled by furi_hal_cortex_init at boot
+#define UNIT "cycles"
+#endif
+
+#define TAG "HirnProfile"
+
+uint32_t hirn_profile_now(void) {
+#ifdef HIRN_HOST
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec);
+#else
+    return DWT->CYCCNT;
+#endif
+}
+
+uint32_t hirn_profile_per_us(void) {
+#ifdef HIRN_HOST
+    return 1000;
+#else
+    return furi_hal_cortex_instructions_per_microsecond();
+#endif
+}
+
+#endif
+
+#ifdef HIRN_PROFILE
+
+typedef struct {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint32_t samples[HIRN_PROFILE_SAMPLES];  // Ring, newest at (count - 1) % HIRN_PROFILE_SAMPLES
+} ProfileStats;
+
+static ProfileStats profile_stats[HirnProfileCount];
+
+static const char* const profile_names[HirnProfileCount] = {
+    "draw_callback",
+    "draw_peg",
+    "evaluate_guess",
+    "generate_secret_code",
+    "input->apply",
+    "input->display",
+};
+
+void hirn_profile_record(HirnProfileId id, uint32_t duration) {
+    ProfileStats* stats = &profile_stats[id];
+    if(stats->count == 0 || duration < stats->min) stats->min = duration;
+    if(duration > stats->max) stats->max = duration;
+    stats->sum += duration;
+    stats->samples[stats->count % HIRN_PROFILE_SAMPLES] = duration;
+    stats->count++;
+}
+
+// Value below which the given share (in percent) of the sorted samples fall
+static uint32_t percentile(const uint32_t* sorted, uint32_t count, uint32_t percent) {
+    return sorted[(count - 1) * percent / 100];
+}
+
+void hirn_profile_dump(void) {
+    static uint32_t sorted[HIRN_PROFILE_SAMPLES];
+    for(int id = 0; id < HirnProfileCount; id++) {
+        ProfileStats* stats = &profile_stats[id];
+        if(stats->count == 0) continue;
+
+        // Insertion sort, the buffer is small and this only runs on exit
+        uint32_t count = stats->count < HIRN_PROFILE_SAMPLES ? stats->count : HIRN_PROFILE_SAMPLES;
+        for(uint32_t i = 0; i < count; i++) {
+            uint32_t value = stats->samples[i];
+            uint32_t j = i;
+            for(; j > 0 && sorted[j - 1] > value; j--) {
+                sorted[j] = sorted[j - 1];
+            }
+            sorted[j] = value;
+        }
+
+        FURI_LOG_I(TAG, "%s: n=%lu min=%lu mean=%lu max=%lu " UNIT, profile_names[id], stats->count,
+                   stats->min, (uint32_t)(stats->sum / stats->count), stats->max);
+        FURI_LOG_I(TAG, "%s: last %lu: p50=%lu p90=%lu p95=%lu p99=%lu " UNIT, profile_names[id], count,
+                   percentile(sorted, count, 50), percentile(sorted, count, 90), percentile(sorted, count, 95),
+                   percentile(sorted, count, 99));
+    }
+    memset(profile_stats, 0, sizeof(profile_stats));
+}
+
+#endif
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <stdint.h>
+
+// ============================================================================
+// Optional profiling. Build with HIRN_PROFILE defined to time the hot spots
+// with the DWT cycle counter (nanoseconds of CLOCK_MONOTONIC on the host).
+// Without it the macros expand to nothing and no code or data is left.
+// The clock alone is also built for HIRN_DEBUG_OVERLAY.
+// ============================================================================
+
+typedef enum {
+    HirnProfileDrawCallback,
+    HirnProfileDrawPeg,
+    HirnProfileEvaluateGuess,
+    HirnProfileGenerateSecret,
+    HirnProfileInputToApply,    // Input event to its state change in the main loop
+    HirnProfileInputToDisplay,  // Input event to the end of the first frame showing it
+    HirnProfileCount
+} HirnProfileId;
+
+#if defined(HIRN_PROFILE) || defined(HIRN_DEBUG_OVERLAY)
+
+// Current time in profile units: CPU cycles on the Flipper, nanoseconds on the host
+uint32_t hirn_profile_now(void);
+
+// Profile units per microsecond
+uint32_t hirn_profile_per_us(void);
+
+#endif
+
+#ifdef HIRN_PROFILE
+
+#define HIRN_PROFILE_SAMPLES 128  // Most recent samples per id, for percentiles
+
+// Each id must only be recorded from one thread
+void hirn_profile_record(HirnProfileId id, uint32_t duration);
+
+// Log min/mean/max and percentiles of every id, then start over
+void hirn_profile_dump(void);
+
+#define HIRN_PROFILE_START(timer) uint32_t timer = hirn_profile_now()
+#define HIRN_PROFILE_STOP(id, timer) hirn_profile_record((id), hirn_profile_now() - (timer))
+#define HIRN_PROFILE_DUMP() hirn_profile_dump()
+
+#else
+
+#define HIRN_PROFILE_START(timer)
+#define HIRN_PROFILE_STOP(id, timer)
+#define HIRN_PROFILE_DUMP()
+
+#endif
@@ -0,0 +1,48 @@
+#include "hirn_random.h"
+
+// splitmix64 step, spreads a seed of any quality over the whole state
+static uint64_t splitmix64(uint64_t* x) {
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+void hirn_random_seed(HirnRandom* random, uint64_t seed) {
+    uint64_t a = splitmix64(&seed);
+    uint64_t b = splitmix64(&seed);
+    random->s[0] = (uint32_t)a;
+    random->s[1] = (uint32_t)(a >> 32);
+    random->s[2] = (uint32_t)b;
+    random->s[3] = (uint32_t)(b >> 32);
+    // xoshiro never leaves the all-zero state; a and b are distinct splitmix64
+    // outputs (a bijection of its counter), so they are never both zero
+}
+
+HirnCode hirn_random_code(HirnRandom* random, HirnVariant variant) {
+    HirnCode code = 0;
+    if(variant.repeat) {
+        for(int i = 0; i < variant.pegs; i++) {
+            code = hirn_code_set(code, i, hirn_random_below(random, variant.colors) + 1);
+        }
+    } else {
+        // Peg i takes a random color from the ones not used yet, swapped out of the pool
+        uint8_t pool[HIRN_MAX_COLORS];
+        for(int c = 0; c < variant.colors; c++) {
+            pool[c] = c + 1;
+        }
+        for(int i = 0; i < variant.pegs; i++) {
+            int j = i + hirn_random_below(random, variant.colors - i);
+            uint8_t color = pool[j];
+            pool[j] = pool[i];
+            pool[i] = color;
+            code = hirn_code_set(code, i, color);
+        }
+    }
+    return code;
+}
+
+uint16_t hirn_random_code_index(HirnRandom* random, HirnVariant variant) {
+    if(variant.repeat) return hirn_random_below(random, hirn_code_space(variant));
+    return hirn_code_index(hirn_random_code(random, variant), variant);
+}
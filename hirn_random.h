@@ -0,0 +1,55 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "hirn_code.h"
+
+// ============================================================================
+// Random numbers: xoshiro128** with a 64-bit seed expanded by splitmix64.
+// Only 32-bit shifts, rotates and one multiply per draw, cheap on the M4.
+// Bounded draws are unbiased (Lemire), so is every code drawn from them.
+// ============================================================================
+
+typedef struct {
+    uint32_t s[4];
+} HirnRandom;
+
+// Same seed, same sequence, on the Flipper and on the host
+void hirn_random_seed(HirnRandom* random, uint64_t seed);
+
+static inline uint32_t hirn_random_rotl(uint32_t x, int k) {
+    return (x << k) | (x >> (32 - k));
+}
+
+static inline uint32_t hirn_random_next(HirnRandom* random) {
+    uint32_t* s = random->s;
+    uint32_t result = hirn_random_rotl(s[1] * 5, 7) * 9;
+    uint32_t t = s[1] << 9;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = hirn_random_rotl(s[3], 11);
+    return result;
+}
+
+// Uniform in [0, bound), bound > 0
+static inline uint32_t hirn_random_below(HirnRandom* random, uint32_t bound) {
+    uint64_t m = (uint64_t)hirn_random_next(random) * bound;
+    if((uint32_t)m < bound) {
+        // Rare slow path: reject the low products that would favour small results
+        uint32_t threshold = -bound % bound;
+        while((uint32_t)m < threshold) {
+            m = (uint64_t)hirn_random_next(random) * bound;
+        }
+    }
+    return m >> 32;
+}
+
+// Uniform secret for variant, in exactly variant.pegs draws
+// (a partial Fisher-Yates shuffle of the colors unless variant.repeat)
+HirnCode hirn_random_code(HirnRandom* random, HirnVariant variant);
+
+// Index of a uniform secret, see hirn_code_index
+uint16_t hirn_random_code_index(HirnRandom* random, HirnVariant variant);
@@ -0,0 +1,40 @@
+#include "hirn_snapshot.h"
+
+#include <string.h>
+
+// The buffers are copied with relaxed atomics, a plain memcpy racing with the
+// writer would be a data race even though the sequence check throws it away
+
+void hirn_snapshot_publish(HirnSnapshot* snapshot, const HirnRenderState* render) {
+    uint32_t words[HIRN_SNAPSHOT_WORDS] = {0};
+    memcpy(words, render, sizeof(HirnRenderState));
+
+    unsigned sequence = atomic_load_explicit(&snapshot->sequence, memory_order_relaxed);
+    atomic_uint* back = snapshot->words[(sequence / 2 + 1) % 2];
+    atomic_store_explicit(&snapshot->sequence, sequence + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);  // Odd sequence is visible before any new word
+    for(size_t i = 0; i < HIRN_SNAPSHOT_WORDS; i++) {
+        atomic_store_explicit(&back[i], words[i], memory_order_relaxed);
+    }
+    atomic_store_explicit(&snapshot->sequence, sequence + 2, memory_order_release);
+}
+
+void hirn_snapshot_read(HirnSnapshot* snapshot, HirnRenderState* render) {
+    // Straight into render, a torn copy is overwritten by the retry. The
+    // caller's copy is the only one on the (GUI thread's) stack.
+    uint8_t* bytes = (uint8_t*)render;
+    unsigned before, after;
+    do {
+        // Even or odd, (before / 2) % 2 is the last completely written buffer
+        before = atomic_load_explicit(&snapshot->sequence, memory_order_acquire);
+        atomic_uint* front = snapshot->words[(before / 2) % 2];
+        for(size_t i = 0; i < HIRN_SNAPSHOT_WORDS; i++) {
+            uint32_t word = atomic_load_explicit(&front[i], memory_order_relaxed);
+            size_t offset = i * 4;
+            memcpy(bytes + offset, &word, offset + 4 <= sizeof(HirnRenderState) ? 4 : sizeof(HirnRenderState) - offset);
+        }
+        atomic_thread_fence(memory_order_acquire);  // Words are read before the sequence again
+        after = atomic_load_explicit(&snapshot->sequence, memory_order_relaxed);
+        // The front buffer is only rewritten once the sequence passes (before & ~1) + 2
+    } while(after - (before & ~1u) > 2);
+}
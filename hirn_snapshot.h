@@ -0,0 +1,47 @@
+#pragma once
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "hirn_game.h"
+#include "hirn_solver.h"
+
+// ============================================================================
+// Render snapshot: everything the draw callback shows, published by the app
+// thread after each change. Double-buffered under a sequence counter: the
+// writer only ever fills the back buffer, so a reader never waits on a writer
+// that got preempted, and retries only if the writer lapped it.
+// ============================================================================
+
+typedef struct {
+    CodeBreakerState state;
+    uint16_t candidates;  // Remaining candidate count
+    int8_t conflict;      // Attempt the current guess contradicts, -1 if none
+    uint32_t hint_budget_ms;  // Budget setting of the hint search
+    int8_t hint_percent;      // Progress of the running hint search, -1 if none
+    bool hint_running;
+    bool has_last_hint;
+    HirnHint last_hint;
+    bool history_open;       // Long Down shows all attempts instead of the board
+    uint8_t history_scroll;  // Pixels the history list is scrolled down by
+    bool settings_open;            // Down on the pause screen opens the settings
+    uint8_t settings_row;          // HirnSettingsRow
+    HirnVariant settings_variant;  // Variant the next round would use, applied with OK
+#ifdef HIRN_DEBUG_OVERLAY
+    bool debug_overlay;  // Long Right toggles the performance overlay
+#endif
+} HirnRenderState;
+
+#define HIRN_SNAPSHOT_WORDS ((sizeof(HirnRenderState) + 3) / 4)
+
+typedef struct {
+    atomic_uint sequence;  // Odd while the back buffer is written, front is (sequence / 2) % 2
+    atomic_uint words[2][HIRN_SNAPSHOT_WORDS];
+} HirnSnapshot;
+
+// Single writer
+void hirn_snapshot_publish(HirnSnapshot* snapshot, const HirnRenderState* render);
+
+// Any number of readers, never blocks
+void hirn_snapshot_read(HirnSnapshot* snapshot, HirnRenderState* render);
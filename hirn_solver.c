@@ -0,0 +1,90 @@
+#include "hirn_solver.h"
+
+#include <furi.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hirn_partition.h"
+
+// Most candidates the search scores each guess against. Larger sets are
+// sampled evenly, which keeps RAM and the time per guess those of the classic
+// game (6^4 codes) in every variant.
+#define SOLVER_MAX_SAMPLE 1296
+
+bool hirn_solver_search(
+    const HirnCandidates* candidates,
+    HirnSolverControl* control,
+    uint32_t budget_ms,
+    HirnHint* hint) {
+    uint32_t start = furi_get_tick();
+    HirnVariant variant = candidates->variant;
+    uint16_t total = candidates->count;
+    atomic_store_explicit(&control->progress, 0, memory_order_relaxed);
+    if(total == 0) return false;
+
+    // Unpack the candidates once, the search scores each of them per guess.
+    // Beyond SOLVER_MAX_SAMPLE only every stride-th one is kept.
+    uint16_t stride = (total + SOLVER_MAX_SAMPLE - 1) / SOLVER_MAX_SAMPLE;
+    uint16_t count = (total + stride - 1) / stride;
+    uint16_t* indices = malloc(count * sizeof(uint16_t));
+    uint16_t filled = 0;
+    uint32_t seen = 0;
+    for(uint32_t word = 0; word < candidates->words; word++) {
+        uint32_t bits = candidates->bits[word];
+        while(bits) {
+            uint32_t bit = __builtin_ctz(bits);
+            bits &= bits - 1;
+            if(seen++ % stride) continue;
+            indices[filled++] = word * 32 + bit;
+        }
+    }
+    HirnPartitionSet set = {0};
+    hirn_partition_set_fill(&set, indices, count, variant, HIRN_PARTITION_NATIVE);
+
+    // Any candidate is a fair answer before the first guess is scored
+    memset(hint, 0, sizeof(HirnHint));
+    hint->guess = indices[0];
+    hint->worst = count;
+
+    uint32_t evaluated = 0;
+    bool complete = true;
+    if(total <= 2) {
+        // Guessing a candidate either wins or leaves the other one
+        hint->worst = 1;
+    } else {
+        // Pass 0 walks the candidates, pass 1 every other guess. Only strict
+        // improvements count, so a non-candidate never displaces an equally
+        // good candidate and ties keep the lowest index. With a sample, the
+        // candidates left out of it are scored in pass 1 like any other guess.
+        // Either way each code is scored once, progress ends at the code space.
+        uint32_t space = hirn_code_space(variant);
+        uint32_t candidate = 0;  // Candidates pass 1 has come across, to find the sampled ones
+        for(int pass = 0; pass < 2 && complete; pass++) {
+            uint32_t end = pass == 0 ? count : space;
+            for(uint32_t i = 0; i < end; i++) {
+                uint16_t index = pass == 0 ? indices[i] : i;
+                if(pass == 1 && hirn_candidates_contains(candidates, index) && candidate++ % stride == 0) continue;
+                if(atomic_load_explicit(&control->stop, memory_order_relaxed) ||
+                   (budget_ms != HIRN_SOLVER_UNLIMITED && furi_get_tick() - start >= budget_ms)) {
+                    complete = false;
+                    break;
+                }
+                uint32_t limit = evaluated ? hint->worst : UINT32_MAX;  // No limit for the seed guess
+                uint16_t worst = hirn_partition_worst(&set, hirn_code_from_index(index, variant), limit);
+                if(worst < limit) {
+                    hint->guess = index;
+                    hint->worst = worst;
+                }
+                evaluated++;
+                atomic_store_explicit(&control->progress, evaluated, memory_order_relaxed);
+            }
+        }
+    }
+
+    hirn_partition_set_free(&set);
+    free(indices);
+    hint->evaluated = evaluated;
+    hint->duration_ms = furi_get_tick() - start;
+    hint->complete = complete;
+    return true;
+}
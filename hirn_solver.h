@@ -0,0 +1,38 @@
+#pragma once
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "hirn_candidates.h"
+
+// ============================================================================
+// Hint solver. Runs on a worker thread, so the caller can watch progress
+// and stop it through HirnSolverControl.
+// ============================================================================
+
+#define HIRN_SOLVER_UNLIMITED 0  // Budget that lets the search run to the end
+
+typedef struct {
+    atomic_bool stop;       // Set by the caller to stop and take the best guess so far
+    atomic_uint progress;   // Guesses evaluated so far, out of hirn_code_space of the variant
+} HirnSolverControl;
+
+typedef struct {
+    uint16_t guess;        // Suggested guess as code index
+    uint16_t worst;        // Its largest feedback partition (of the sample, see hirn_solver.c)
+    uint32_t evaluated;    // Guesses scored against the candidates
+    uint32_t duration_ms;
+    bool complete;         // The whole guess space was searched
+} HirnHint;
+
+// Anytime version of Knuth's minimax: the guess whose worst-case feedback
+// leaves the fewest candidates. Candidates are tried first, then the rest of
+// the guess space, so ties go to candidates and then to the lowest index.
+// Stops when told to or once budget_ms (or HIRN_SOLVER_UNLIMITED) is used
+// up, and returns the best guess so far. False only if there are no candidates.
+bool hirn_solver_search(
+    const HirnCandidates* candidates,
+    HirnSolverControl* control,
+    uint32_t budget_ms,
+    HirnHint* hint);
@@ -0,0 +1,197 @@
+#include "hirn_sprite.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    uint8_t* bits;
+    int stride;
+} Bitmap;
+
+static void plot(const Bitmap* bitmap, int x, int y) {
+    bitmap->bits[y * bitmap->stride + x / 8] |= 1u << (x % 8);
+}
+
+static void hline(const Bitmap* bitmap, int x0, int x1, int y) {
+    for(int x = x0; x <= x1; x++) {
+        plot(bitmap, x, y);
+    }
+}
+
+static void vline(const Bitmap* bitmap, int x, int y0, int y1) {
+    for(int y = y0; y <= y1; y++) {
+        plot(bitmap, x, y);
+    }
+}
+
+// u8g2_DrawCircle with U8G2_DRAW_ALL: midpoint circle, eight octants per step
+static void circle(const Bitmap* bitmap, int x0, int y0, int radius) {
+    int f = 1 - radius;
+    int ddf_x = 1;
+    int ddf_y = -2 * radius;
+    int x = 0;
+    int y = radius;
+    for(;;) {
+        plot(bitmap, x0 + x, y0 - y);
+        plot(bitmap, x0 + y, y0 - x);
+        plot(bitmap, x0 - x, y0 - y);
+        plot(bitmap, x0 - y, y0 - x);
+        plot(bitmap, x0 + x, y0 + y);
+        plot(bitmap, x0 + y, y0 + x);
+        plot(bitmap, x0 - x, y0 + y);
+        plot(bitmap, x0 - y, y0 + x);
+        if(x >= y) break;
+        if(f >= 0) {
+            y--;
+            ddf_y += 2;
+            f += ddf_y;
+        }
+        x++;
+        ddf_x += 2;
+        f += ddf_x;
+    }
+}
+
+// u8g2_DrawDisc with U8G2_DRAW_ALL: the same walk, filled with vertical lines
+static void disc(const Bitmap* bitmap, int x0, int y0, int radius) {
+    int f = 1 - radius;
+    int ddf_x = 1;
+    int ddf_y = -2 * radius;
+    int x = 0;
+    int y = radius;
+    for(;;) {
+        vline(bitmap, x0 + x, y0 - y, y0 + y);
+        vline(bitmap, x0 - x, y0 - y, y0 + y);
+        vline(bitmap, x0 + y, y0 - x, y0 + x);
+        vline(bitmap, x0 - y, y0 - x, y0 + x);
+        if(x >= y) break;
+        if(f >= 0) {
+            y--;
+            ddf_y += 2;
+            f += ddf_y;
+        }
+        x++;
+        ddf_x += 2;
+        f += ddf_x;
+    }
+}
+
+void hirn_circle_spans(int radius, uint8_t spans[HIRN_SPRITE_MAX_RADIUS + 1]) {
+    // The half width only shrinks as d grows, so one walk down from radius covers all rows
+    int half = radius;
+    for(int d = 0; d <= radius; d++) {
+        while(half * half > radius * radius - d * d) half--;
+        spans[d] = half;
+    }
+}
+
+// Horizontal (and/or vertical) hatch lines every 3 pixels, clipped to the circle
+static void hatch(const Bitmap* bitmap, int c, int radius, const uint8_t* spans, bool horizontal, bool vertical) {
+    for(int i = -radius; i <= radius; i += 3) {
+        int half = spans[abs(i)];
+        if(horizontal) hline(bitmap, c - half, c + half, c + i);
+        if(vertical) vline(bitmap, c + i, c - half, c + half);
+    }
+}
+
+// Dots on a 3 pixel grid, clipped to the inside of the circle
+static void dots(const Bitmap* bitmap, int c, int radius, const uint8_t* spans) {
+    for(int i = -radius + 2; i <= radius - 2; i += 3) {
+        for(int j = -radius + 2; j <= radius - 2; j += 3) {
+            if(abs(j) < spans[abs(i)]) plot(bitmap, c + j, c + i);
+        }
+    }
+}
+
+// Diagonal hatch lines every 4 pixels, rising for slope 1 and falling for slope -1
+static void diagonals(const Bitmap* bitmap, int c, int radius, const uint8_t* spans, int slope) {
+    for(int offset = -radius * 2; offset <= radius * 2; offset += 4) {
+        for(int i = -radius; i <= radius; i++) {
+            int j = slope * i + offset;
+            if(abs(j) <= spans[abs(i)]) plot(bitmap, c + i, c - j);
+        }
+    }
+}
+
+void hirn_sprite_rasterize(uint8_t* bits, PegColor color, int radius) {
+    Bitmap bitmap = {.bits = bits, .stride = HIRN_SPRITE_STRIDE(radius)};
+    int c = radius;  // Center
+    uint8_t spans[HIRN_SPRITE_MAX_RADIUS + 1];
+    hirn_circle_spans(radius, spans);
+    memset(bits, 0, bitmap.stride * HIRN_SPRITE_SIZE(radius));
+
+    switch(color) {
+    case COLOR_NONE:
+        // Empty circle
+        circle(&bitmap, c, c, radius);
+        break;
+    case COLOR_RED:
+        // Solid fill
+        disc(&bitmap, c, c, radius);
+        break;
+    case COLOR_GREEN:
+        // Horizontal lines
+        circle(&bitmap, c, c, radius);
+        hatch(&bitmap, c, radius, spans, true, false);
+        break;
+    case COLOR_BLUE:
+        // Vertical lines
+        circle(&bitmap, c, c, radius);
+        hatch(&bitmap, c, radius, spans, false, true);
+        break;
+    case COLOR_YELLOW:
+        // Diagonal lines (/)
+        circle(&bitmap, c, c, radius);
+        diagonals(&bitmap, c, radius, spans, 1);
+        break;
+    case COLOR_PURPLE:
+        // Diagonal lines (\)
+        circle(&bitmap, c, c, radius);
+        diagonals(&bitmap, c, radius, spans, -1);
+        break;
+    case COLOR_ORANGE:
+        // Cross-hatch
+        circle(&bitmap, c, c, radius);
+        hatch(&bitmap, c, radius, spans, true, true);
+        break;
+    case COLOR_CYAN:
+        // Dots
+        circle(&bitmap, c, c, radius);
+        dots(&bitmap, c, radius, spans);
+        break;
+    case COLOR_PINK:
+        // Ring: a second circle halfway in
+        circle(&bitmap, c, c, radius);
+        circle(&bitmap, c, c, radius / 2);
+        break;
+    }
+}
+
+void hirn_sprite_cache_reset(HirnSpriteCache* cache) {
+    memset(cache, 0, sizeof(HirnSpriteCache));
+}
+
+const uint8_t* hirn_sprite_get(HirnSpriteCache* cache, PegColor color, int radius) {
+    int slot = -1;
+    for(int s = 0; s < HIRN_SPRITE_SLOTS; s++) {
+        if(cache->ready[s] && cache->radius[s] == radius) slot = s;
+    }
+    if(slot < 0) {
+        // New radius: take a free slot, or evict round-robin
+        for(int s = HIRN_SPRITE_SLOTS - 1; s >= 0; s--) {
+            if(!cache->ready[s]) slot = s;
+        }
+        if(slot < 0) {
+            slot = cache->next_evict;
+            cache->next_evict = (slot + 1) % HIRN_SPRITE_SLOTS;
+        }
+        cache->radius[slot] = radius;
+        cache->ready[slot] = 0;
+    }
+    uint8_t* bits = cache->bits[slot][color];
+    if(!(cache->ready[slot] & (1u << color))) {
+        hirn_sprite_rasterize(bits, color, radius);
+        cache->ready[slot] |= 1u << color;
+    }
+    return bits;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "hirn_code.h"
+
+// ============================================================================
+// Peg sprites: each (color, radius) pattern rasterized once into a 1-bit XBM
+// bitmap (rows padded to whole bytes, leftmost pixel in bit 0), then drawn
+// with a single canvas_draw_xbm. Circles and discs follow u8g2's algorithms,
+// so a sprite matches canvas_draw_circle/canvas_draw_disc pixel for pixel.
+// ============================================================================
+
+#define HIRN_SPRITE_MAX_RADIUS 8
+#define HIRN_SPRITE_SIZE(radius) (2 * (radius) + 1)  // Width and height
+#define HIRN_SPRITE_STRIDE(radius) ((HIRN_SPRITE_SIZE(radius) + 7) / 8)
+#define HIRN_SPRITE_BYTES (HIRN_SPRITE_STRIDE(HIRN_SPRITE_MAX_RADIUS) * HIRN_SPRITE_SIZE(HIRN_SPRITE_MAX_RADIUS))
+#define HIRN_SPRITE_SLOTS 3  // Radii cached at once, the board uses two, the history a third
+
+// Not thread-safe, meant to be owned by the draw callback
+typedef struct {
+    uint8_t radius[HIRN_SPRITE_SLOTS];
+    uint16_t ready[HIRN_SPRITE_SLOTS];  // Bit c set once color c is rasterized, 0 for a free slot
+    uint8_t next_evict;                 // Slot to reuse when a new radius comes along
+    uint8_t bits[HIRN_SPRITE_SLOTS][HIRN_MAX_COLORS + 1][HIRN_SPRITE_BYTES];
+} HirnSpriteCache;
+
+void hirn_sprite_cache_reset(HirnSpriteCache* cache);
+
+// Sprite of a peg centered at (radius, radius), rasterized on first use.
+// radius must not exceed HIRN_SPRITE_MAX_RADIUS.
+const uint8_t* hirn_sprite_get(HirnSpriteCache* cache, PegColor color, int radius);
+
+// Half widths of a disc: spans[d] = floor(sqrt(radius^2 - d^2)) for d = 0..radius,
+// so (dx, dy) lies inside iff |dx| <= spans[|dy|]. Integer only.
+void hirn_circle_spans(int radius, uint8_t spans[HIRN_SPRITE_MAX_RADIUS + 1]);
+
+// Rasterize a peg into bits (HIRN_SPRITE_STRIDE(radius) bytes per row)
+void hirn_sprite_rasterize(uint8_t* bits, PegColor color, int radius);
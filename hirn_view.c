@@ -0,0 +1,441 @@
+#include "hirn_view.h"
+
+#include <furi.h>          // Logging and ticks (host/furi.h on Linux)
+#include <gui/elements.h>  // GUI elements library for button hints and UI components
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hirn_code.h"     // Packed codes and feedback classes
+#include "hirn_profile.h"  // Optional timing, see HIRN_PROFILE
+#include "mitzi_hirn_icons.h"
+
+#define PEG_Y_POSITION 22   // Vertical position for current guessing pegs
+#define FEEDBACK_RADIUS 3   
+#define CURSOR_SIZE 20      // Size of cursor box (height, and width up to 4 pegs)
+#define HUD_X_POSITION 65   // X position for HUD (timer and attempts counter)
+
+// Horizontal geometry per peg count, narrower for more pegs so the guess
+// still ends left of the labels on the right
+typedef struct {
+    uint8_t cursor;          // Cursor box width and peg spacing on the board
+    uint8_t history_radius;  // Peg radius on the history screen
+} PegLayout;
+
+static const PegLayout peg_layouts[HIRN_PEG_COUNTS] = {
+    {.cursor = 20, .history_radius = 5},  // 3 pegs
+    {.cursor = 20, .history_radius = 5},  // 4 pegs
+    {.cursor = 16, .history_radius = 5},  // 5 pegs
+    {.cursor = 14, .history_radius = 4},  // 6 pegs
+};
+
+static const PegLayout* peg_layout(int pegs) {
+    return &peg_layouts[pegs - HIRN_MIN_PEGS];
+}
+
+// Center of the first peg, half a cursor in from the left edge
+#define PEG_X_POSITION(layout) ((layout)->cursor / 2)
+
+// ============================================================================
+// Drawing Functions
+// ============================================================================
+
+// Draw modal dialog box with text
+static void draw_simple_modal(Canvas* canvas, const char* text) {
+	canvas_set_font(canvas, FontPrimary);
+    const int box_w = canvas_string_width(canvas, text) + 6;
+    const int box_h = 20;
+    const int box_x = 2;
+    const int box_y = 20;
+    // White filled rectangle
+    canvas_set_color(canvas, ColorWhite);
+    canvas_draw_box(canvas, box_x, box_y, box_w, box_h);
+    // Black border
+    canvas_set_color(canvas, ColorBlack);
+    canvas_draw_frame(canvas, box_x, box_y, box_w, box_h);
+    // Text inside
+    canvas_draw_str(canvas, box_x + 2, box_y + 14, text);
+	canvas_set_font(canvas, FontSecondary);
+}
+
+// Draw the settings line of the pause screen, changed with Left/Right
+static void draw_pause_settings(Canvas* canvas, const HirnRenderState* render) {
+    char line[24];
+    canvas_set_color(canvas, ColorWhite);
+    canvas_draw_box(canvas, 0, 42, 128, 10);
+    canvas_set_color(canvas, ColorBlack);
+    uint32_t budget_ms = render->hint_budget_ms;
+    if(budget_ms == HIRN_SOLVER_UNLIMITED) {
+        snprintf(line, sizeof(line), "Hint: < no limit >");
+    } else {
+        snprintf(line, sizeof(line), "Hint: < %lu ms >", (unsigned long)budget_ms);
+    }
+    canvas_draw_str(canvas, 4, 50, line);
+    if(render->has_last_hint) {
+        // Time the last hint took
+        snprintf(line, sizeof(line), "last %lu ms", (unsigned long)render->last_hint.duration_ms);
+        canvas_draw_str_aligned(canvas, 127, 50, AlignRight, AlignBottom, line);
+    }
+}
+
+// Bottom left hint of the pause screen: Down opens the settings
+static void draw_setup_hint(Canvas* canvas) {
+    // Small down arrow
+    for(int i = 0; i < 3; i++) {
+        canvas_draw_line(canvas, 1 + i, 57 + i, 5 - i, 57 + i);
+    }
+    canvas_draw_str_aligned(canvas, 7, 63, AlignLeft, AlignBottom, "Setup");
+}
+
+// Draw a peg with its pattern, one blit of the cached sprite
+static void draw_peg(Canvas* canvas, HirnSpriteCache* sprites, int x, int y, int radius, PegColor color) {
+    HIRN_PROFILE_START(profile);
+    int size = HIRN_SPRITE_SIZE(radius);
+    canvas_draw_xbm(canvas, x - radius, y - radius, size, size, hirn_sprite_get(sprites, color, radius));
+    HIRN_PROFILE_STOP(HirnProfileDrawPeg, profile);
+}
+
+// Columns of the feedback grid, two rows
+static int feedback_columns(int pegs) {
+    return (pegs + 1) / 2;
+}
+
+// Draw feedback pegs (2 rows, 2x2 for 4 pegs): black ones first, then white ones
+static void draw_feedback(Canvas* canvas, int x, int y, FeedbackClass feedback, int radius, int pegs) {
+    int spacing = radius * 2 + 2;  // Space between feedback pegs
+    int columns = feedback_columns(pegs);
+    int black = hirn_feedback_blacks(feedback, pegs);
+    int white = hirn_feedback_whites(feedback, pegs);
+    uint8_t spans[HIRN_SPRITE_MAX_RADIUS + 1];
+    hirn_circle_spans(radius, spans);
+    
+    for(int i = 0; i < pegs; i++) {
+        int px = x + i % columns * spacing;
+        int py = y + i / columns * spacing;
+        canvas_draw_circle(canvas, px, py, radius); // draw circle outline
+        if(i < black) {
+            canvas_draw_disc(canvas, px, py, radius);
+        } else if(i < black + white) { // grey dot pattern fill
+            for(int dy = -radius; dy <= radius; dy += 2) {
+                for(int dx = -radius; dx <= radius; dx += 2) {
+                    if(abs(dx) <= spans[abs(dy)]) {
+                        canvas_draw_dot(canvas, px + dx, py + dy);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// ============================================================================
+// History Screen
+// ============================================================================
+
+#define HISTORY_PEG_X 24      // Center of the first peg
+#define HISTORY_FEEDBACK_RADIUS 2
+
+// Scroll position bar along the right edge
+static void draw_scrollbar(Canvas* canvas, int scroll, int max_scroll) {
+    int content = max_scroll + HIRN_HISTORY_HEIGHT;
+    int thumb = HIRN_HISTORY_HEIGHT * HIRN_HISTORY_HEIGHT / content;
+    int y = HIRN_HISTORY_TOP + scroll * HIRN_HISTORY_HEIGHT / content;
+    canvas_draw_line(canvas, 126, HIRN_HISTORY_TOP, 126, 63);
+    canvas_draw_box(canvas, 125, y, 3, thumb);
+}
+
+// All attempts, newest on top. Only the rows inside the viewport are drawn,
+// all pegs share one sprite radius.
+static void draw_history(Canvas* canvas, const HirnRenderState* render, HirnSpriteCache* sprites) {
+    const CodeBreakerState* state = &render->state;
+    int pegs = state->variant.pegs;
+    int radius = peg_layout(pegs)->history_radius;
+    int step = 2 * radius + 3;  // Peg spacing
+    int feedback_x = HISTORY_PEG_X + pegs * step + 4;
+    int scroll = render->history_scroll;
+    int first = scroll / HIRN_HISTORY_ROW_HEIGHT;
+    int last = (scroll + HIRN_HISTORY_HEIGHT - 1) / HIRN_HISTORY_ROW_HEIGHT;
+    if(last > state->attempts_used - 1) last = state->attempts_used - 1;
+
+    canvas_set_font(canvas, FontSecondary);
+    for(int row = first; row <= last; row++) {
+        int attempt = state->attempts_used - 1 - row;
+        int y = HIRN_HISTORY_TOP + row * HIRN_HISTORY_ROW_HEIGHT - scroll + HIRN_HISTORY_ROW_HEIGHT / 2;
+        char label[4];
+        snprintf(label, sizeof(label), "%d", attempt + 1);
+        canvas_draw_str_aligned(canvas, 14, y, AlignRight, AlignCenter, label);
+        HirnCode guess = hirn_code_from_index(state->guess_history[attempt], state->variant);
+        for(int i = 0; i < pegs; i++) {
+            draw_peg(canvas, sprites, HISTORY_PEG_X + i * step, y, radius, hirn_code_get(guess, i));
+        }
+        draw_feedback(
+            canvas, feedback_x, y - 3, state->feedback_history[attempt], HISTORY_FEEDBACK_RADIUS, pegs);
+        // The attempt the current guess contradicts
+        if(attempt == render->conflict && state->state == STATE_PLAYING) {
+            int marker_x = feedback_x + feedback_columns(pegs) * (2 * HISTORY_FEEDBACK_RADIUS + 2) + 2;
+            canvas_draw_str_aligned(canvas, marker_x, y, AlignLeft, AlignCenter, "!");
+        }
+    }
+
+    // Title bar, over the row scrolled partly under it
+    canvas_set_color(canvas, ColorWhite);
+    canvas_draw_box(canvas, 0, 0, 128, HIRN_HISTORY_TOP);
+    canvas_set_color(canvas, ColorBlack);
+    canvas_set_font(canvas, FontPrimary);
+    canvas_draw_str_aligned(canvas, 1, 1, AlignLeft, AlignTop, "History");
+    canvas_set_font(canvas, FontSecondary);
+    char time_str[12];
+    uint32_t seconds = get_total_time(state) / 1000;
+    snprintf(time_str, sizeof(time_str), "%02lu:%02lu", (unsigned long)(seconds / 60), (unsigned long)(seconds % 60));
+    canvas_draw_str_aligned(canvas, 127, 1, AlignRight, AlignTop, time_str);
+    canvas_draw_line(canvas, 0, HIRN_HISTORY_TOP - 2, 127, HIRN_HISTORY_TOP - 2);
+
+    int max_scroll = hirn_history_max_scroll(state->attempts_used);
+    if(max_scroll > 0) draw_scrollbar(canvas, scroll, max_scroll);
+}
+
+// ============================================================================
+// Settings Screen
+// ============================================================================
+
+#define SETTINGS_TOP 13        // First row, below the title bar
+#define SETTINGS_ROW_HEIGHT 11
+
+// Hint budget and the variant of the next round, the selected row inverted
+static void draw_settings(Canvas* canvas, const HirnRenderState* render) {
+    const HirnVariant* variant = &render->settings_variant;
+    canvas_set_font(canvas, FontPrimary);
+    canvas_draw_str_aligned(canvas, 1, 1, AlignLeft, AlignTop, "Setup");
+    canvas_set_font(canvas, FontSecondary);
+    canvas_draw_str_aligned(canvas, 127, 1, AlignRight, AlignTop, "OK: apply");
+    canvas_draw_line(canvas, 0, SETTINGS_TOP - 3, 127, SETTINGS_TOP - 3);
+
+    for(int row = 0; row < HirnSettingsRowCount; row++) {
+        const char* label = "";
+        char value[16];
+        switch(row) {
+        case HirnSettingsRowHint:
+            label = "Hint";
+            if(render->hint_budget_ms == HIRN_SOLVER_UNLIMITED) {
+                snprintf(value, sizeof(value), "no limit");
+            } else {
+                snprintf(value, sizeof(value), "%lu ms", (unsigned long)render->hint_budget_ms);
+            }
+            break;
+        case HirnSettingsRowPegs:
+            label = "Pegs";
+            snprintf(value, sizeof(value), "%d", variant->pegs);
+            break;
+        case HirnSettingsRowColors:
+            label = "Colors";
+            snprintf(value, sizeof(value), "%d", variant->colors);
+            break;
+        case HirnSettingsRowRepeat:
+            label = "Repeat";
+            snprintf(value, sizeof(value), "%s", variant->repeat ? "yes" : "no");
+            break;
+        }
+        int y = SETTINGS_TOP + row * SETTINGS_ROW_HEIGHT;
+        if(row == render->settings_row) {
+            canvas_draw_box(canvas, 0, y, 128, SETTINGS_ROW_HEIGHT);
+            canvas_set_color(canvas, ColorWhite);
+        }
+        char shown[20];
+        snprintf(shown, sizeof(shown), "< %s >", value);
+        canvas_draw_str_aligned(canvas, 3, y + 2, AlignLeft, AlignTop, label);
+        canvas_draw_str_aligned(canvas, 125, y + 2, AlignRight, AlignTop, shown);
+        canvas_set_color(canvas, ColorBlack);
+    }
+
+    // What applying would do to the game in progress
+    if(!hirn_variant_equal(*variant, render->state.variant)) {
+        canvas_draw_str_aligned(canvas, 64, 63, AlignCenter, AlignBottom, "OK starts a new round");
+    }
+}
+
+// ============================================================================
+// Game Screen
+// ============================================================================
+
+#define VIEW_BUFFER_SIZE (128 * 64 / 8)
+
+// Everything on the board but the HUD clock and the cursor, which
+// draw_board_overlay adds. Nothing of one overlaps the other.
+static void draw_board_background(Canvas* canvas, const HirnRenderState* render, HirnSpriteCache* sprites) {
+    const CodeBreakerState* state = &render->state;
+    canvas_set_font(canvas, FontSecondary);
+    
+	// Draw header with icon and title
+    canvas_set_font(canvas, FontPrimary);
+	canvas_draw_icon(canvas, 1, 1, &I_icon_10x10);	
+	canvas_draw_str_aligned(canvas, 13, 1, AlignLeft, AlignTop, "HIRN");
+	canvas_set_font(canvas, FontSecondary);
+	
+    uint32_t total_time = get_total_time(state);
+	canvas_draw_str_aligned(canvas, 127, 8, AlignRight, AlignTop, "f418.eu"); 
+    canvas_draw_str_aligned(canvas, 127, 16, AlignRight, AlignTop, "v0.2"); 	
+    // Remaining candidates, below the version where the guess pegs don't reach
+    char candidates_str[12];
+    snprintf(candidates_str, sizeof(candidates_str), "C: %d", (int)render->candidates);
+    canvas_draw_str_aligned(canvas, 127, 24, AlignRight, AlignTop, candidates_str);
+    
+    // Draw current guess area
+    int pegs = state->variant.pegs;
+    const PegLayout* layout = peg_layout(pegs);
+    int peg_radius = layout->cursor / 2 - 2;  // Peg radius is slightly smaller than half cursor
+    int peg_spacing = layout->cursor;         // Pegs touch when cursors would touch
+    int feedback_radius = (CURSOR_SIZE / 8 > 2) ? CURSOR_SIZE / 8 : 3; // Feedback pegs scale with cursor, min 3
+    int guess_y = PEG_Y_POSITION;   // Vertical position
+
+    for(int i = 0; i < pegs; i++) {
+        int x = PEG_X_POSITION(layout) + i * peg_spacing;
+        draw_peg(canvas, sprites, x, guess_y, peg_radius, hirn_code_get(state->current_guess, i));
+    }
+        
+	// Draw last guess from history (directly below current guess)
+	if(state->attempts_used > 0) {
+		int history_y = guess_y + CURSOR_SIZE;  // Below current guess with spacing
+		HirnCode last_guess = hirn_code_from_index(state->guess_history[state->attempts_used - 1], state->variant);
+		for(int i = 0; i < pegs; i++) {
+			int x = PEG_X_POSITION(layout) + i * peg_spacing;
+			draw_peg(canvas, sprites, x, history_y, peg_radius - 2, hirn_code_get(last_guess, i));
+		}
+    draw_feedback(canvas, PEG_X_POSITION(layout) + pegs * peg_spacing + 5, history_y - 5, state->feedback_history[state->attempts_used - 1], feedback_radius, pegs);
+}
+
+    // Inconsistent guess marker right of the guess, naming the attempt once the guess is complete
+    if(render->conflict >= 0 && state->state == STATE_PLAYING) {
+        char conflict_str[8];
+        if(is_guess_complete(state)) {
+            snprintf(conflict_str, sizeof(conflict_str), "!%d", render->conflict + 1);
+        } else {
+            snprintf(conflict_str, sizeof(conflict_str), "!");
+        }
+        canvas_draw_str_aligned(
+            canvas, PEG_X_POSITION(layout) + pegs * peg_spacing - layout->cursor / 2 + 3, guess_y, AlignLeft, AlignCenter, conflict_str);
+    }
+	
+	
+    // Construct status message
+	const char* modal_text = NULL;
+    if(state->state == STATE_PAUSED) {
+        modal_text = "Paused.";
+    } else if(state->state == STATE_WON) {
+        modal_text = "You won!";
+    } else if(state->state == STATE_LOST) {
+        if(total_time >= MAX_TIME_MS) {
+            modal_text = "Time out :-(";
+        } else {
+            modal_text = "No attempts left :-(";
+        }
+    }
+    
+    // Draw secret code if revealed or game ended
+    if(state->state == STATE_REVEAL || state->state == STATE_WON || state->state == STATE_LOST) {
+        canvas_set_font(canvas, FontSecondary);
+        canvas_draw_str(canvas, 10, 120, "Code:");
+        for(int i = 0; i < pegs; i++) {
+            draw_peg(canvas, sprites, 45 + i * 20, 120, 8, hirn_code_get(state->secret_code, i));
+        }
+    }
+	
+    if(modal_text) {
+		draw_simple_modal(canvas, modal_text);
+		if(state->state == STATE_PAUSED) {
+		    draw_pause_settings(canvas, render);
+		    draw_setup_hint(canvas);
+		}
+		// When modal is shown, only show exit hint
+	    canvas_draw_icon(canvas, 121, 57, &I_back);
+	    canvas_draw_str_aligned(canvas, 120, 63, AlignRight, AlignBottom, "Exit");	
+   	} else {
+	    // Normal hints, or the progress of a running hint search
+	    canvas_draw_icon(canvas, 1, 55, &I_arrows);
+	    if(render->hint_percent >= 0) {
+	        char hint_str[12];
+	        snprintf(hint_str, sizeof(hint_str), "Hint %d%%", render->hint_percent);
+	        canvas_draw_str_aligned(canvas, 11, 62, AlignLeft, AlignBottom, hint_str);
+	    } else {
+	        canvas_draw_str_aligned(canvas, 11, 62, AlignLeft, AlignBottom, "Navigate");
+	    }
+	    canvas_draw_icon(canvas, 121, 57, &I_back);
+	    canvas_draw_str_aligned(canvas, 120, 63, AlignRight, AlignBottom, "Pause");
+	}
+
+    if(state->state == STATE_PLAYING && is_guess_complete(state) && is_guess_different(state)) {
+        elements_button_center(canvas, "OK");
+    } else if(state->state == STATE_PAUSED) {
+        elements_button_center(canvas, "Resume");
+    } else if(state->state == STATE_WON || state->state == STATE_LOST) {
+        elements_button_center(canvas, "Play again");
+    }
+}
+
+// The parts of the board that change while nothing else does
+static void draw_board_overlay(Canvas* canvas, const HirnRenderState* render) {
+    const CodeBreakerState* state = &render->state;
+    canvas_set_color(canvas, ColorBlack);
+    canvas_set_font(canvas, FontSecondary);
+
+    // Draw HUD (top right)
+    char time_str[20];
+    uint32_t total_time = get_total_time(state);
+    uint32_t seconds = total_time / 1000;
+    uint32_t minutes = seconds / 60;
+    seconds = seconds % 60;
+    snprintf(time_str, sizeof(time_str), "A: %d(%d) %02lu:%02lu", state->attempts_used, MAX_ATTEMPTS,
+             (unsigned long)minutes, (unsigned long)seconds);
+    canvas_draw_str(canvas, HUD_X_POSITION, 7, time_str);
+
+    // Draw cursor rectangle
+    if(state->state == STATE_PLAYING) {
+        const PegLayout* layout = peg_layout(state->variant.pegs);
+        int x = PEG_X_POSITION(layout) + state->cursor_position * layout->cursor;
+        canvas_draw_rframe(canvas, x - layout->cursor/2, PEG_Y_POSITION - CURSOR_SIZE/2, layout->cursor + 1, CURSOR_SIZE + 1, 2);
+    }
+}
+
+// The background depends on everything but the cursor; the clock is
+// computed from the tick and the unchanging start time. Compared in place,
+// a key copy would cost the GUI thread another snapshot of stack.
+static bool background_matches(const HirnRenderState* render, const HirnViewCache* cache) {
+    const uint8_t* a = (const uint8_t*)render;
+    const uint8_t* b = (const uint8_t*)&cache->background_key;
+    size_t cursor = offsetof(HirnRenderState, state.cursor_position);
+    size_t rest = cursor + sizeof(render->state.cursor_position);
+    return cache->background_valid && !memcmp(a, b, cursor) &&
+           !memcmp(a + rest, b + rest, sizeof(HirnRenderState) - rest);
+}
+
+void hirn_view_cache_reset(HirnViewCache* cache) {
+    hirn_sprite_cache_reset(&cache->sprites);
+    cache->background_valid = false;
+}
+
+void hirn_view_draw(Canvas* canvas, const HirnRenderState* render, HirnViewCache* cache) {
+    canvas_clear(canvas);
+    if(render->settings_open) {
+        draw_settings(canvas, render);
+        return;
+    }
+    if(render->history_open) {
+        draw_history(canvas, render, &cache->sprites);
+        return;
+    }
+
+    // Only the display's own framebuffer can be copied
+    uint8_t* buffer = canvas_get_buffer(canvas);
+    if(canvas_get_buffer_size(canvas) != VIEW_BUFFER_SIZE) {
+        draw_board_background(canvas, render, &cache->sprites);
+        draw_board_overlay(canvas, render);
+        return;
+    }
+
+    if(background_matches(render, cache)) {
+        memcpy(buffer, cache->background, VIEW_BUFFER_SIZE);
+    } else {
+        draw_board_background(canvas, render, &cache->sprites);
+        memcpy(cache->background, buffer, VIEW_BUFFER_SIZE);
+        memcpy(&cache->background_key, render, sizeof(HirnRenderState));
+        cache->background_valid = true;
+    }
+    draw_board_overlay(canvas, render);
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <gui/gui.h>
+
+#include "hirn_snapshot.h"
+#include "hirn_sprite.h"
+
+// ============================================================================
+// Game screen. Draws only from a render snapshot, so it runs the same on the
+// Flipper's GUI thread and on the headless canvas of the host build.
+// ============================================================================
+
+// History screen geometry, shared with the scrolling in hirn.c
+#define HIRN_HISTORY_TOP 12  // First pixel row below the title bar
+#define HIRN_HISTORY_HEIGHT (64 - HIRN_HISTORY_TOP)
+#define HIRN_HISTORY_ROW_HEIGHT 13
+
+// Largest scroll offset of the history list in pixels
+static inline int hirn_history_max_scroll(int attempts) {
+    int content = attempts * HIRN_HISTORY_ROW_HEIGHT;
+    return content > HIRN_HISTORY_HEIGHT ? content - HIRN_HISTORY_HEIGHT : 0;
+}
+
+// Rows of the settings screen, Up/Down select one, Left/Right change it
+typedef enum {
+    HirnSettingsRowHint,
+    HirnSettingsRowPegs,
+    HirnSettingsRowColors,
+    HirnSettingsRowRepeat,
+    HirnSettingsRowCount,
+} HirnSettingsRow;
+
+// What the view keeps between frames, one per drawing thread. Zeroed memory
+// is a valid empty cache.
+typedef struct {
+    HirnSpriteCache sprites;
+    // Board without clock and cursor, as last drawn for background_key (its
+    // cursor is ignored)
+    HirnRenderState background_key;
+    bool background_valid;
+    uint8_t background[128 * 64 / 8];
+} HirnViewCache;
+
+void hirn_view_cache_reset(HirnViewCache* cache);
+
+// Draw the whole screen. The board is copied from the cached background
+// unless something on it changed, then the clock and cursor go on top.
+void hirn_view_draw(Canvas* canvas, const HirnRenderState* render, HirnViewCache* cache);
@@ -0,0 +1,461 @@
+// Canvas primitives for the host build, drawing into a 1-bit framebuffer.
+// Shapes follow u8g2 (the Flipper's graphics library) pixel for pixel. Text
+// uses a built-in 5x7 font: close to the firmware's fonts in size, but not
+// the same glyphs, so string pixels differ from the device.
+
+#include <gui/elements.h>
+#include <gui/gui.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define WIDTH 128
+#define HEIGHT 64
+#define FONT_ASCENT 7
+
+struct Canvas {
+    uint8_t buffer[WIDTH * HEIGHT / 8];
+    Color color;
+    Font font;
+};
+
+// 5x7 glyphs for ' ' to '~', one byte per column, bit 0 the top row
+static const uint8_t font_5x7[95][5] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00}, {0x00, 0x00, 0x5F, 0x00, 0x00}, {0x00, 0x07, 0x00, 0x07, 0x00},
+    {0x14, 0x7F, 0x14, 0x7F, 0x14}, {0x24, 0x2A, 0x7F, 0x2A, 0x12}, {0x23, 0x13, 0x08, 0x64, 0x62},
+    {0x36, 0x49, 0x55, 0x22, 0x50}, {0x00, 0x05, 0x03, 0x00, 0x00}, {0x00, 0x1C, 0x22, 0x41, 0x00},
+    {0x00, 0x41, 0x22, 0x1C, 0x00}, {0x08, 0x2A, 0x1C, 0x2A, 0x08}, {0x08, 0x08, 0x3E, 0x08, 0x08},
+    {0x00, 0x50, 0x30, 0x00, 0x00}, {0x08, 0x08, 0x08, 0x08, 0x08}, {0x00, 0x60, 0x60, 0x00, 0x00},
+    {0x20, 0x10, 0x08, 0x04, 0x02}, {0x3E, 0x51, 0x49, 0x45, 0x3E}, {0x00, 0x42, 0x7F, 0x40, 0x00},
+    {0x42, 0x61, 0x51, 0x49, 0x46}, {0x21, 0x41, 0x45, 0x4B, 0x31}, {0x18, 0x14, 0x12, 0x7F, 0x10},
+    {0x27, 0x45, 0x45, 0x45, 0x39}, {0x3C, 0x4A, 0x49, 0x49, 0x30}, {0x01, 0x71, 0x09, 0x05, 0x03},
+    {0x36, 0x49, 0x49, 0x49, 0x36}, {0x06, 0x49, 0x49, 0x29, 0x1E}, {0x00, 0x36, 0x36, 0x00, 0x00},
+    {0x00, 0x56, 0x36, 0x00, 0x00}, {0x08, 0x14, 0x22, 0x41, 0x00}, {0x14, 0x14, 0x14, 0x14, 0x14},
+    {0x00, 0x41, 0x22, 0x14, 0x08}, {0x02, 0x01, 0x51, 0x09, 0x06}, {0x32, 0x49, 0x79, 0x41, 0x3E},
+    {0x7E, 0x11, 0x11, 0x11, 0x7E}, {0x7F, 0x49, 0x49, 0x49, 0x36}, {0x3E, 0x41, 0x41, 0x41, 0x22},
+    {0x7F, 0x41, 0x41, 0x22, 0x1C}, {0x7F, 0x49, 0x49, 0x49, 0x41}, {0x7F, 0x09, 0x09, 0x01, 0x01},
+    {0x3E, 0x41, 0x41, 0x51, 0x32}, {0x7F, 0x08, 0x08, 0x08, 0x7F}, {0x00, 0x41, 0x7F, 0x41, 0x00},
+    {0x20, 0x40, 0x41, 0x3F, 0x01}, {0x7F, 0x08, 0x14, 0x22, 0x41}, {0x7F, 0x40, 0x40, 0x40, 0x40},
+    {0x7F, 0x02, 0x04, 0x02, 0x7F}, {0x7F, 0x04, 0x08, 0x10, 0x7F}, {0x3E, 0x41, 0x41, 0x41, 0x3E},
+    {0x7F, 0x09, 0x09, 0x09, 0x06}, {0x3E, 0x41, 0x51, 0x21, 0x5E}, {0x7F, 0x09, 0x19, 0x29, 0x46},
+    {0x46, 0x49, 0x49, 0x49, 0x31}, {0x01, 0x01, 0x7F, 0x01, 0x01}, {0x3F, 0x40, 0x40, 0x40, 0x3F},
+    {0x1F, 0x20, 0x40, 0x20, 0x1F}, {0x7F, 0x20, 0x18, 0x20, 0x7F}, {0x63, 0x14, 0x08, 0x14, 0x63},
+    {0x03, 0x04, 0x78, 0x04, 0x03}, {0x61, 0x51, 0x49, 0x45, 0x43}, {0x00, 0x7F, 0x41, 0x41, 0x00},
+    {0x02, 0x04, 0x08, 0x10, 0x20}, {0x00, 0x41, 0x41, 0x7F, 0x00}, {0x04, 0x02, 0x01, 0x02, 0x04},
+    {0x40, 0x40, 0x40, 0x40, 0x40}, {0x00, 0x01, 0x02, 0x04, 0x00}, {0x20, 0x54, 0x54, 0x54, 0x78},
+    {0x7F, 0x48, 0x44, 0x44, 0x38}, {0x38, 0x44, 0x44, 0x44, 0x20}, {0x38, 0x44, 0x44, 0x48, 0x7F},
+    {0x38, 0x54, 0x54, 0x54, 0x18}, {0x08, 0x7E, 0x09, 0x01, 0x02}, {0x08, 0x54, 0x54, 0x54, 0x3C},
+    {0x7F, 0x08, 0x04, 0x04, 0x78}, {0x00, 0x44, 0x7D, 0x40, 0x00}, {0x20, 0x40, 0x44, 0x3D, 0x00},
+    {0x7F, 0x10, 0x28, 0x44, 0x00}, {0x00, 0x41, 0x7F, 0x40, 0x00}, {0x7C, 0x04, 0x18, 0x04, 0x78},
+    {0x7C, 0x08, 0x04, 0x04, 0x78}, {0x38, 0x44, 0x44, 0x44, 0x38}, {0x7C, 0x14, 0x14, 0x14, 0x08},
+    {0x08, 0x14, 0x14, 0x18, 0x7C}, {0x7C, 0x08, 0x04, 0x04, 0x08}, {0x48, 0x54, 0x54, 0x54, 0x20},
+    {0x04, 0x3F, 0x44, 0x40, 0x20}, {0x3C, 0x40, 0x40, 0x20, 0x7C}, {0x1C, 0x20, 0x40, 0x20, 0x1C},
+    {0x3C, 0x40, 0x30, 0x40, 0x3C}, {0x44, 0x28, 0x10, 0x28, 0x44}, {0x0C, 0x50, 0x50, 0x50, 0x3C},
+    {0x44, 0x64, 0x54, 0x4C, 0x44}, {0x00, 0x08, 0x36, 0x41, 0x00}, {0x00, 0x00, 0x7F, 0x00, 0x00},
+    {0x00, 0x41, 0x36, 0x08, 0x00}, {0x08, 0x04, 0x08, 0x10, 0x08},
+};
+
+// OK button icon of elements_button_center
+static const uint8_t button_center_data[] = {0x1c, 0x22, 0x49, 0x5d, 0x49, 0x22, 0x1c};
+static const Icon button_center = {.width = 7, .height = 7, .data = button_center_data};
+
+// ============================================================================
+// Pixels
+// ============================================================================
+
+static void plot(Canvas* canvas, int32_t x, int32_t y) {
+    if(x < 0 || x >= WIDTH || y < 0 || y >= HEIGHT) return;
+    uint8_t* byte = &canvas->buffer[(y / 8) * WIDTH + x];
+    uint8_t mask = 1u << (y % 8);
+    if(canvas->color == ColorBlack) {
+        *byte |= mask;
+    } else if(canvas->color == ColorWhite) {
+        *byte &= ~mask;
+    } else {
+        *byte ^= mask;
+    }
+}
+
+static void hline(Canvas* canvas, int32_t x, int32_t y, int32_t length) {
+    for(int32_t i = 0; i < length; i++) {
+        plot(canvas, x + i, y);
+    }
+}
+
+static void vline(Canvas* canvas, int32_t x, int32_t y, int32_t length) {
+    for(int32_t i = 0; i < length; i++) {
+        plot(canvas, x, y + i);
+    }
+}
+
+// ============================================================================
+// Canvas API
+// ============================================================================
+
+void canvas_clear(Canvas* canvas) {
+    memset(canvas->buffer, 0, sizeof(canvas->buffer));
+}
+
+void canvas_set_color(Canvas* canvas, Color color) {
+    canvas->color = color;
+}
+
+void canvas_invert_color(Canvas* canvas) {
+    canvas->color = canvas->color == ColorBlack ? ColorWhite : canvas->color == ColorWhite ? ColorBlack : ColorXOR;
+}
+
+void canvas_set_font(Canvas* canvas, Font font) {
+    canvas->font = font;
+}
+
+size_t canvas_width(const Canvas* canvas) {
+    (void)canvas;
+    return WIDTH;
+}
+
+size_t canvas_height(const Canvas* canvas) {
+    (void)canvas;
+    return HEIGHT;
+}
+
+size_t canvas_current_font_height(const Canvas* canvas) {
+    return canvas->font == FontPrimary ? FONT_ASCENT + 1 : FONT_ASCENT;
+}
+
+uint8_t* canvas_get_buffer(Canvas* canvas) {
+    return canvas->buffer;
+}
+
+size_t canvas_get_buffer_size(const Canvas* canvas) {
+    return sizeof(canvas->buffer);
+}
+
+void canvas_draw_dot(Canvas* canvas, int32_t x, int32_t y) {
+    plot(canvas, x, y);
+}
+
+// u8g2_DrawLine: Bresenham, stepping along the longer axis
+void canvas_draw_line(Canvas* canvas, int32_t x1, int32_t y1, int32_t x2, int32_t y2) {
+    int32_t tmp;
+    int32_t dx = abs(x2 - x1);
+    int32_t dy = abs(y2 - y1);
+    bool swapxy = dy > dx;
+    if(swapxy) {
+        tmp = dx, dx = dy, dy = tmp;
+        tmp = x1, x1 = y1, y1 = tmp;
+        tmp = x2, x2 = y2, y2 = tmp;
+    }
+    if(x1 > x2) {
+        tmp = x1, x1 = x2, x2 = tmp;
+        tmp = y1, y1 = y2, y2 = tmp;
+    }
+    int32_t err = dx >> 1;
+    int32_t ystep = y2 > y1 ? 1 : -1;
+    int32_t y = y1;
+    for(int32_t x = x1; x <= x2; x++) {
+        if(swapxy) {
+            plot(canvas, y, x);
+        } else {
+            plot(canvas, x, y);
+        }
+        err -= dy;
+        if(err < 0) {
+            y += ystep;
+            err += dx;
+        }
+    }
+}
+
+void canvas_draw_box(Canvas* canvas, int32_t x, int32_t y, size_t width, size_t height) {
+    for(size_t i = 0; i < height; i++) {
+        hline(canvas, x, y + i, width);
+    }
+}
+
+// u8g2_DrawFrame: the sides leave out the corners, so XOR frames stay closed
+void canvas_draw_frame(Canvas* canvas, int32_t x, int32_t y, size_t width, size_t height) {
+    hline(canvas, x, y, width);
+    if(height < 2) return;
+    vline(canvas, x, y + 1, height - 2);
+    vline(canvas, x + width - 1, y + 1, height - 2);
+    hline(canvas, x, y + height - 1, width);
+}
+
+// Octants of a circle as drawn by u8g2, 0x0F for all of them
+#define DRAW_UPPER_RIGHT 0x01
+#define DRAW_UPPER_LEFT 0x02
+#define DRAW_LOWER_LEFT 0x04
+#define DRAW_LOWER_RIGHT 0x08
+
+static void circle_section(Canvas* canvas, int32_t x, int32_t y, int32_t x0, int32_t y0, uint8_t option) {
+    if(option & DRAW_UPPER_RIGHT) {
+        plot(canvas, x0 + x, y0 - y);
+        plot(canvas, x0 + y, y0 - x);
+    }
+    if(option & DRAW_UPPER_LEFT) {
+        plot(canvas, x0 - x, y0 - y);
+        plot(canvas, x0 - y, y0 - x);
+    }
+    if(option & DRAW_LOWER_RIGHT) {
+        plot(canvas, x0 + x, y0 + y);
+        plot(canvas, x0 + y, y0 + x);
+    }
+    if(option & DRAW_LOWER_LEFT) {
+        plot(canvas, x0 - x, y0 + y);
+        plot(canvas, x0 - y, y0 + x);
+    }
+}
+
+static void disc_section(Canvas* canvas, int32_t x, int32_t y, int32_t x0, int32_t y0) {
+    vline(canvas, x0 + x, y0 - y, y + 1);
+    vline(canvas, x0 + y, y0 - x, x + 1);
+    vline(canvas, x0 - x, y0 - y, y + 1);
+    vline(canvas, x0 - y, y0 - x, x + 1);
+    vline(canvas, x0 + x, y0, y + 1);
+    vline(canvas, x0 + y, y0, x + 1);
+    vline(canvas, x0 - x, y0, y + 1);
+    vline(canvas, x0 - y, y0, x + 1);
+}
+
+// Midpoint circle walk of u8g2_DrawCircle and u8g2_DrawDisc
+static void circle_walk(Canvas* canvas, int32_t x0, int32_t y0, int32_t radius, uint8_t option, bool filled) {
+    int32_t f = 1 - radius;
+    int32_t ddf_x = 1;
+    int32_t ddf_y = -2 * radius;
+    int32_t x = 0;
+    int32_t y = radius;
+    for(;;) {
+        if(filled) {
+            disc_section(canvas, x, y, x0, y0);
+        } else {
+            circle_section(canvas, x, y, x0, y0, option);
+        }
+        if(x >= y) break;
+        if(f >= 0) {
+            y--;
+            ddf_y += 2;
+            f += ddf_y;
+        }
+        x++;
+        ddf_x += 2;
+        f += ddf_x;
+    }
+}
+
+void canvas_draw_circle(Canvas* canvas, int32_t x, int32_t y, size_t radius) {
+    circle_walk(canvas, x, y, radius, 0x0F, false);
+}
+
+void canvas_draw_disc(Canvas* canvas, int32_t x, int32_t y, size_t radius) {
+    circle_walk(canvas, x, y, radius, 0x0F, true);
+}
+
+// u8g2_DrawRFrame: quarter circles in the corners, straight lines between
+void canvas_draw_rframe(Canvas* canvas, int32_t x, int32_t y, size_t width, size_t height, size_t radius) {
+    int32_t w = width, h = height, r = radius;
+    int32_t xl = x + r, yu = y + r;
+    int32_t xr = x + w - r - 1, yl = y + h - r - 1;
+    circle_walk(canvas, xl, yu, r, DRAW_UPPER_LEFT, false);
+    circle_walk(canvas, xr, yu, r, DRAW_UPPER_RIGHT, false);
+    circle_walk(canvas, xl, yl, r, DRAW_LOWER_LEFT, false);
+    circle_walk(canvas, xr, yl, r, DRAW_LOWER_RIGHT, false);
+    int32_t ww = w - 2 * r, hh = h - 2 * r;
+    if(ww >= 3) {
+        hline(canvas, xl + 1, y, ww - 2);
+        hline(canvas, xl + 1, y + h - 1, ww - 2);
+    }
+    if(hh >= 3) {
+        vline(canvas, x, yu + 1, hh - 2);
+        vline(canvas, x + w - 1, yu + 1, hh - 2);
+    }
+}
+
+// Set bits in the current color, clear ones left alone
+void canvas_draw_xbm(Canvas* canvas, int32_t x, int32_t y, size_t width, size_t height, const uint8_t* bitmap) {
+    size_t stride = (width + 7) / 8;
+    for(size_t row = 0; row < height; row++) {
+        for(size_t column = 0; column < width; column++) {
+            if(bitmap[row * stride + column / 8] & (1u << (column % 8))) plot(canvas, x + column, y + row);
+        }
+    }
+}
+
+void canvas_draw_icon(Canvas* canvas, int32_t x, int32_t y, const Icon* icon) {
+    canvas_draw_xbm(canvas, x, y, icon->width, icon->height, icon->data);
+}
+
+// ============================================================================
+// Text
+// ============================================================================
+
+// Primary is the same font drawn bold, one pixel wider
+static int32_t glyph_advance(const Canvas* canvas) {
+    return canvas->font == FontPrimary ? 7 : 6;
+}
+
+uint16_t canvas_string_width(Canvas* canvas, const char* str) {
+    size_t length = strlen(str);
+    return length ? length * glyph_advance(canvas) - 1 : 0;
+}
+
+// Baseline at y, like u8g2_DrawStr
+void canvas_draw_str(Canvas* canvas, int32_t x, int32_t y, const char* str) {
+    int32_t bold = canvas->font == FontPrimary ? 1 : 0;
+    for(; *str; str++, x += glyph_advance(canvas)) {
+        unsigned char c = *str;
+        if(c < ' ' || c > '~') c = '?';
+        const uint8_t* glyph = font_5x7[c - ' '];
+        for(int32_t column = 0; column < 5; column++) {
+            for(int32_t row = 0; row < 8; row++) {
+                if(!(glyph[column] & (1u << row))) continue;
+                plot(canvas, x + column, y - FONT_ASCENT + row);
+                if(bold) plot(canvas, x + column + 1, y - FONT_ASCENT + row);
+            }
+        }
+    }
+}
+
+void canvas_draw_str_aligned(Canvas* canvas, int32_t x, int32_t y, Align horizontal, Align vertical, const char* str) {
+    if(horizontal == AlignRight) {
+        x -= canvas_string_width(canvas, str);
+    } else if(horizontal == AlignCenter) {
+        x -= canvas_string_width(canvas, str) / 2;
+    }
+    if(vertical == AlignTop) {
+        y += FONT_ASCENT;
+    } else if(vertical == AlignCenter) {
+        y += FONT_ASCENT / 2;
+    }
+    canvas_draw_str(canvas, x, y, str);
+}
+
+// ============================================================================
+// Elements
+// ============================================================================
+
+// Same geometry as the firmware's elements_button_center
+void elements_button_center(Canvas* canvas, const char* str) {
+    const int32_t button_height = 12;
+    const int32_t vertical_offset = 3;
+    const int32_t horizontal_offset = 1;
+    const int32_t icon_width_with_offset = button_center.width + 3;
+    const int32_t icon_v_offset = button_center.height + vertical_offset;
+    const int32_t button_width = canvas_string_width(canvas, str) + horizontal_offset * 2 + icon_width_with_offset;
+    const int32_t x = (WIDTH - button_width) / 2;
+    const int32_t y = HEIGHT;
+
+    canvas_draw_box(canvas, x, y - button_height, button_width, button_height);
+    for(int32_t i = 1; i <= 3; i++) {
+        canvas_draw_line(canvas, x - i, y, x - i, y - button_height + i - 1);
+        canvas_draw_line(canvas, x + button_width + i - 1, y, x + button_width + i - 1, y - button_height + i - 1);
+    }
+
+    canvas_invert_color(canvas);
+    canvas_draw_icon(canvas, x + horizontal_offset, y - icon_v_offset, &button_center);
+    canvas_draw_str(canvas, x + horizontal_offset + icon_width_with_offset, y - vertical_offset, str);
+    canvas_invert_color(canvas);
+}
+
+// ============================================================================
+// Host only
+// ============================================================================
+
+Canvas* canvas_host_alloc(void) {
+    Canvas* canvas = calloc(1, sizeof(Canvas));
+    canvas->color = ColorBlack;
+    canvas->font = FontSecondary;
+    return canvas;
+}
+
+void canvas_host_free(Canvas* canvas) {
+    free(canvas);
+}
+
+bool canvas_host_get_pixel(const Canvas* canvas, int32_t x, int32_t y) {
+    return (canvas->buffer[(y / 8) * WIDTH + x] >> (y % 8)) & 1;
+}
+
+// PBM rows: leftmost pixel in the top bit, 1 for black
+static void pbm_rows(const Canvas* canvas, uint8_t rows[HEIGHT][WIDTH / 8]) {
+    memset(rows, 0, HEIGHT * WIDTH / 8);
+    for(int32_t y = 0; y < HEIGHT; y++) {
+        for(int32_t x = 0; x < WIDTH; x++) {
+            if(canvas_host_get_pixel(canvas, x, y)) rows[y][x / 8] |= 0x80 >> (x % 8);
+        }
+    }
+}
+
+bool canvas_host_write_pbm(const Canvas* canvas, const char* path) {
+    uint8_t rows[HEIGHT][WIDTH / 8];
+    pbm_rows(canvas, rows);
+    FILE* file = fopen(path, "wb");
+    if(!file) return false;
+    fprintf(file, "P4\n%d %d\n", WIDTH, HEIGHT);
+    bool ok = fwrite(rows, sizeof(rows), 1, file) == 1;
+    return fclose(file) == 0 && ok;
+}
+
+int32_t canvas_host_diff_pbm(const Canvas* canvas, const char* path) {
+    uint8_t rows[HEIGHT][WIDTH / 8], golden[HEIGHT][WIDTH / 8];
+    int width, height;
+    FILE* file = fopen(path, "rb");
+    if(!file) return -1;
+    bool ok = fscanf(file, "P4 %d %d", &width, &height) == 2 && width == WIDTH && height == HEIGHT &&
+              fgetc(file) != EOF && fread(golden, sizeof(golden), 1, file) == 1;
+    fclose(file);
+    if(!ok) return -1;
+
+    pbm_rows(canvas, rows);
+    int32_t diff = 0;
+    for(int32_t y = 0; y < HEIGHT; y++) {
+        for(int32_t i = 0; i < WIDTH / 8; i++) {
+            diff += __builtin_popcount(rows[y][i] ^ golden[y][i]);
+        }
+    }
+    return diff;
+}
+
+// ============================================================================
+// View ports, they only keep their callbacks
+// ============================================================================
+
+struct ViewPort {
+    ViewPortDrawCallback draw_callback;
+    void* draw_context;
+    ViewPortInputCallback input_callback;
+    void* input_context;
+};
+
+ViewPort* view_port_alloc(void) {
+    return calloc(1, sizeof(ViewPort));
+}
+
+void view_port_free(ViewPort* view_port) {
+    free(view_port);
+}
+
+void view_port_draw_callback_set(ViewPort* view_port, ViewPortDrawCallback callback, void* context) {
+    view_port->draw_callback = callback;
+    view_port->draw_context = context;
+}
+
+void view_port_input_callback_set(ViewPort* view_port, ViewPortInputCallback callback, void* context) {
+    view_port->input_callback = callback;
+    view_port->input_context = context;
+}
+
+void view_port_update(ViewPort* view_port) {
+    (void)view_port;
+}
+
+void gui_add_view_port(Gui* gui, ViewPort* view_port, GuiLayer layer) {
+    (void)gui;
+    (void)view_port;
+    (void)layer;
+}
+
+void gui_remove_view_port(Gui* gui, ViewPort* view_port) {
+    (void)gui;
+    (void)view_port;
+}
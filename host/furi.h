@@ -0,0 +1,131 @@
+#pragma once
+
+// ============================================================================
+// Minimal stand-in for the Furi API, just enough to build the game on Linux:
+// tick clock, logging, a blocking message queue, threads, timers and records.
+// ============================================================================
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define UNUSED(x) (void)(x)
+
+#define furi_assert(expr) ((void)(expr))
+#define furi_check(expr) \
+    do {                 \
+        if(!(expr)) abort(); \
+    } while(0)
+
+typedef enum {
+    FuriStatusOk = 0,
+    FuriStatusError = -1,
+    FuriStatusErrorTimeout = -2,
+    FuriStatusErrorResource = -3,
+    FuriStatusErrorParameter = -4,
+} FuriStatus;
+
+#define FuriWaitForever 0xFFFFFFFFU
+
+// ============================================================================
+// Kernel
+// ============================================================================
+
+// Milliseconds since the first call, like the 1 kHz Furi tick
+uint32_t furi_get_tick(void);
+uint32_t furi_kernel_get_tick_frequency(void);
+void furi_delay_ms(uint32_t milliseconds);
+
+// ============================================================================
+// Logging
+// ============================================================================
+
+typedef enum {
+    FuriLogLevelDefault = 0,
+    FuriLogLevelNone = 1,
+    FuriLogLevelError = 2,
+    FuriLogLevelWarn = 3,
+    FuriLogLevelInfo = 4,
+    FuriLogLevelDebug = 5,
+    FuriLogLevelTrace = 6,
+} FuriLogLevel;
+
+void furi_log_set_level(FuriLogLevel level);
+FuriLogLevel furi_log_get_level(void);
+// No format attribute: device code uses %lu for uint32_t, which is correct on
+// ARM but would warn here.
+void furi_log_print_format(FuriLogLevel level, const char* tag, const char* format, ...);
+
+#define FURI_LOG_E(tag, format, ...) furi_log_print_format(FuriLogLevelError, tag, format, ##__VA_ARGS__)
+#define FURI_LOG_W(tag, format, ...) furi_log_print_format(FuriLogLevelWarn, tag, format, ##__VA_ARGS__)
+#define FURI_LOG_I(tag, format, ...) furi_log_print_format(FuriLogLevelInfo, tag, format, ##__VA_ARGS__)
+#define FURI_LOG_D(tag, format, ...) furi_log_print_format(FuriLogLevelDebug, tag, format, ##__VA_ARGS__)
+#define FURI_LOG_T(tag, format, ...) furi_log_print_format(FuriLogLevelTrace, tag, format, ##__VA_ARGS__)
+
+// ============================================================================
+// Message queue
+// ============================================================================
+
+typedef struct FuriMessageQueue FuriMessageQueue;
+
+FuriMessageQueue* furi_message_queue_alloc(uint32_t msg_count, uint32_t msg_size);
+void furi_message_queue_free(FuriMessageQueue* instance);
+FuriStatus furi_message_queue_put(FuriMessageQueue* instance, const void* msg_ptr, uint32_t timeout);
+FuriStatus furi_message_queue_get(FuriMessageQueue* instance, void* msg_ptr, uint32_t timeout);
+uint32_t furi_message_queue_get_count(FuriMessageQueue* instance);
+void furi_message_queue_reset(FuriMessageQueue* instance);
+
+// ============================================================================
+// Threads
+// ============================================================================
+
+typedef int32_t (*FuriThreadCallback)(void* context);
+typedef struct FuriThread FuriThread;
+
+// The stack size is ignored, host threads get the default one
+FuriThread* furi_thread_alloc_ex(const char* name, uint32_t stack_size, FuriThreadCallback callback, void* context);
+void furi_thread_free(FuriThread* thread);
+void furi_thread_start(FuriThread* thread);
+bool furi_thread_join(FuriThread* thread);
+
+typedef void* FuriThreadId;
+
+FuriThreadId furi_thread_get_current_id(void);
+// Free stack of a thread in bytes, unknown (0) on the host
+uint32_t furi_thread_get_stack_space(FuriThreadId thread_id);
+
+// Free heap in bytes, unknown (0) on the host
+size_t memmgr_get_free_heap(void);
+
+// ============================================================================
+// Timers, their callbacks run on one thread per timer
+// ============================================================================
+
+typedef void (*FuriTimerCallback)(void* context);
+
+typedef enum {
+    FuriTimerTypeOnce = 0,
+    FuriTimerTypePeriodic = 1,
+} FuriTimerType;
+
+typedef struct FuriTimer FuriTimer;
+
+FuriTimer* furi_timer_alloc(FuriTimerCallback callback, FuriTimerType type, void* context);
+void furi_timer_free(FuriTimer* instance);
+FuriStatus furi_timer_start(FuriTimer* instance, uint32_t ticks);
+FuriStatus furi_timer_stop(FuriTimer* instance);
+uint32_t furi_timer_is_running(FuriTimer* instance);
+
+static inline uint32_t furi_ms_to_ticks(uint32_t milliseconds) {
+    return milliseconds;  // 1 kHz tick
+}
+
+// ============================================================================
+// Records, there are no services behind them
+// ============================================================================
+
+void* furi_record_open(const char* name);
+void furi_record_close(const char* name);
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <stdint.h>
+
+// ============================================================================
+// Stand-in for the Furi HAL: only the random source the app seeds from.
+// ============================================================================
+
+uint32_t furi_hal_random_get(void);
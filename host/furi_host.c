@@ -0,0 +1,360 @@
+#include <furi.h>
+#include <furi_hal.h>
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <time.h>
+
+// ============================================================================
+// Kernel
+// ============================================================================
+
+static uint64_t host_now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+}
+
+static pthread_once_t tick_once = PTHREAD_ONCE_INIT;
+static uint64_t tick_origin;
+
+static void tick_init(void) {
+    tick_origin = host_now_ms();
+}
+
+uint32_t furi_get_tick(void) {
+    pthread_once(&tick_once, tick_init);
+    return (uint32_t)(host_now_ms() - tick_origin);
+}
+
+uint32_t furi_kernel_get_tick_frequency(void) {
+    return 1000;
+}
+
+void furi_delay_ms(uint32_t milliseconds) {
+    struct timespec ts = {milliseconds / 1000, (long)(milliseconds % 1000) * 1000000L};
+    while(nanosleep(&ts, &ts) != 0 && errno == EINTR) {
+    }
+}
+
+// ============================================================================
+// Logging
+// ============================================================================
+
+static FuriLogLevel log_level = FuriLogLevelInfo;
+
+void furi_log_set_level(FuriLogLevel level) {
+    log_level = level == FuriLogLevelDefault ? FuriLogLevelInfo : level;
+}
+
+FuriLogLevel furi_log_get_level(void) {
+    return log_level;
+}
+
+void furi_log_print_format(FuriLogLevel level, const char* tag, const char* format, ...) {
+    if(level > log_level) return;
+    static const char letters[] = "??EWIDT";
+    fprintf(stderr, "%lu [%c][%s] ", (unsigned long)furi_get_tick(), letters[level], tag);
+    va_list args;
+    va_start(args, format);
+    vfprintf(stderr, format, args);
+    va_end(args);
+    fputc('\n', stderr);
+}
+
+// ============================================================================
+// Message queue
+// ============================================================================
+
+struct FuriMessageQueue {
+    pthread_mutex_t mutex;
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+    uint32_t msg_count;
+    uint32_t msg_size;
+    uint32_t head;
+    uint32_t count;
+    uint8_t* buffer;
+};
+
+FuriMessageQueue* furi_message_queue_alloc(uint32_t msg_count, uint32_t msg_size) {
+    FuriMessageQueue* instance = malloc(sizeof(FuriMessageQueue));
+    pthread_mutex_init(&instance->mutex, NULL);
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&instance->not_empty, &attr);
+    pthread_cond_init(&instance->not_full, &attr);
+    pthread_condattr_destroy(&attr);
+    instance->msg_count = msg_count;
+    instance->msg_size = msg_size;
+    instance->head = 0;
+    instance->count = 0;
+    instance->buffer = malloc((size_t)msg_count * msg_size);
+    return instance;
+}
+
+void furi_message_queue_free(FuriMessageQueue* instance) {
+    pthread_cond_destroy(&instance->not_full);
+    pthread_cond_destroy(&instance->not_empty);
+    pthread_mutex_destroy(&instance->mutex);
+    free(instance->buffer);
+    free(instance);
+}
+
+// Wait on cond until pred holds; false once timeout (in ticks) expires
+static bool queue_wait(FuriMessageQueue* instance, pthread_cond_t* cond, bool (*pred)(FuriMessageQueue*), uint32_t timeout) {
+    if(timeout == FuriWaitForever) {
+        while(!pred(instance)) pthread_cond_wait(cond, &instance->mutex);
+        return true;
+    }
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += timeout / 1000;
+    deadline.tv_nsec += (long)(timeout % 1000) * 1000000L;
+    if(deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+    while(!pred(instance)) {
+        if(pthread_cond_timedwait(cond, &instance->mutex, &deadline) == ETIMEDOUT) return pred(instance);
+    }
+    return true;
+}
+
+static bool queue_has_space(FuriMessageQueue* instance) {
+    return instance->count < instance->msg_count;
+}
+
+static bool queue_has_message(FuriMessageQueue* instance) {
+    return instance->count > 0;
+}
+
+FuriStatus furi_message_queue_put(FuriMessageQueue* instance, const void* msg_ptr, uint32_t timeout) {
+    pthread_mutex_lock(&instance->mutex);
+    if(!queue_wait(instance, &instance->not_full, queue_has_space, timeout)) {
+        pthread_mutex_unlock(&instance->mutex);
+        return timeout ? FuriStatusErrorTimeout : FuriStatusErrorResource;
+    }
+    uint32_t tail = (instance->head + instance->count) % instance->msg_count;
+    memcpy(instance->buffer + (size_t)tail * instance->msg_size, msg_ptr, instance->msg_size);
+    instance->count++;
+    pthread_cond_signal(&instance->not_empty);
+    pthread_mutex_unlock(&instance->mutex);
+    return FuriStatusOk;
+}
+
+FuriStatus furi_message_queue_get(FuriMessageQueue* instance, void* msg_ptr, uint32_t timeout) {
+    pthread_mutex_lock(&instance->mutex);
+    if(!queue_wait(instance, &instance->not_empty, queue_has_message, timeout)) {
+        pthread_mutex_unlock(&instance->mutex);
+        return timeout ? FuriStatusErrorTimeout : FuriStatusErrorResource;
+    }
+    memcpy(msg_ptr, instance->buffer + (size_t)instance->head * instance->msg_size, instance->msg_size);
+    instance->head = (instance->head + 1) % instance->msg_count;
+    instance->count--;
+    pthread_cond_signal(&instance->not_full);
+    pthread_mutex_unlock(&instance->mutex);
+    return FuriStatusOk;
+}
+
+uint32_t furi_message_queue_get_count(FuriMessageQueue* instance) {
+    pthread_mutex_lock(&instance->mutex);
+    uint32_t count = instance->count;
+    pthread_mutex_unlock(&instance->mutex);
+    return count;
+}
+
+void furi_message_queue_reset(FuriMessageQueue* instance) {
+    pthread_mutex_lock(&instance->mutex);
+    instance->head = 0;
+    instance->count = 0;
+    pthread_cond_broadcast(&instance->not_full);
+    pthread_mutex_unlock(&instance->mutex);
+}
+
+// ============================================================================
+// Threads
+// ============================================================================
+
+struct FuriThread {
+    pthread_t handle;
+    FuriThreadCallback callback;
+    void* context;
+    bool started;
+};
+
+FuriThread* furi_thread_alloc_ex(const char* name, uint32_t stack_size, FuriThreadCallback callback, void* context) {
+    UNUSED(name);
+    UNUSED(stack_size);
+    FuriThread* thread = calloc(1, sizeof(FuriThread));
+    thread->callback = callback;
+    thread->context = context;
+    return thread;
+}
+
+void furi_thread_free(FuriThread* thread) {
+    furi_thread_join(thread);
+    free(thread);
+}
+
+static void* thread_body(void* arg) {
+    FuriThread* thread = arg;
+    thread->callback(thread->context);
+    return NULL;
+}
+
+void furi_thread_start(FuriThread* thread) {
+    furi_check(!thread->started);
+    thread->started = true;
+    furi_check(pthread_create(&thread->handle, NULL, thread_body, thread) == 0);
+}
+
+bool furi_thread_join(FuriThread* thread) {
+    if(!thread->started) return true;
+    pthread_join(thread->handle, NULL);
+    thread->started = false;
+    return true;
+}
+
+FuriThreadId furi_thread_get_current_id(void) {
+    return (FuriThreadId)pthread_self();
+}
+
+uint32_t furi_thread_get_stack_space(FuriThreadId thread_id) {
+    UNUSED(thread_id);
+    return 0;
+}
+
+size_t memmgr_get_free_heap(void) {
+    return 0;
+}
+
+// ============================================================================
+// Timers
+// ============================================================================
+
+struct FuriTimer {
+    pthread_t handle;
+    pthread_mutex_t mutex;
+    pthread_cond_t changed;
+    FuriTimerCallback callback;
+    void* context;
+    FuriTimerType type;
+    uint32_t period;
+    uint64_t deadline;  // host_now_ms() of the next expiry while running
+    bool running;
+    bool quit;
+};
+
+static void* timer_body(void* arg) {
+    FuriTimer* timer = arg;
+    pthread_mutex_lock(&timer->mutex);
+    while(!timer->quit) {
+        if(!timer->running) {
+            pthread_cond_wait(&timer->changed, &timer->mutex);
+            continue;
+        }
+        uint64_t now = host_now_ms();
+        if(now < timer->deadline) {
+            struct timespec until;
+            clock_gettime(CLOCK_MONOTONIC, &until);
+            uint64_t ns = (uint64_t)until.tv_nsec + (timer->deadline - now) * 1000000ULL;
+            until.tv_sec += ns / 1000000000ULL;
+            until.tv_nsec = ns % 1000000000ULL;
+            pthread_cond_timedwait(&timer->changed, &timer->mutex, &until);
+            continue;
+        }
+        if(timer->type == FuriTimerTypePeriodic) {
+            timer->deadline += timer->period;
+        } else {
+            timer->running = false;
+        }
+        pthread_mutex_unlock(&timer->mutex);
+        timer->callback(timer->context);
+        pthread_mutex_lock(&timer->mutex);
+    }
+    pthread_mutex_unlock(&timer->mutex);
+    return NULL;
+}
+
+FuriTimer* furi_timer_alloc(FuriTimerCallback callback, FuriTimerType type, void* context) {
+    FuriTimer* timer = calloc(1, sizeof(FuriTimer));
+    pthread_mutex_init(&timer->mutex, NULL);
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&timer->changed, &attr);
+    pthread_condattr_destroy(&attr);
+    timer->callback = callback;
+    timer->context = context;
+    timer->type = type;
+    furi_check(pthread_create(&timer->handle, NULL, timer_body, timer) == 0);
+    return timer;
+}
+
+void furi_timer_free(FuriTimer* instance) {
+    pthread_mutex_lock(&instance->mutex);
+    instance->quit = true;
+    pthread_cond_signal(&instance->changed);
+    pthread_mutex_unlock(&instance->mutex);
+    pthread_join(instance->handle, NULL);
+    pthread_cond_destroy(&instance->changed);
+    pthread_mutex_destroy(&instance->mutex);
+    free(instance);
+}
+
+FuriStatus furi_timer_start(FuriTimer* instance, uint32_t ticks) {
+    pthread_mutex_lock(&instance->mutex);
+    instance->period = ticks;
+    instance->deadline = host_now_ms() + ticks;
+    instance->running = true;
+    pthread_cond_signal(&instance->changed);
+    pthread_mutex_unlock(&instance->mutex);
+    return FuriStatusOk;
+}
+
+FuriStatus furi_timer_stop(FuriTimer* instance) {
+    pthread_mutex_lock(&instance->mutex);
+    instance->running = false;
+    pthread_cond_signal(&instance->changed);
+    pthread_mutex_unlock(&instance->mutex);
+    return FuriStatusOk;
+}
+
+uint32_t furi_timer_is_running(FuriTimer* instance) {
+    pthread_mutex_lock(&instance->mutex);
+    bool running = instance->running;
+    pthread_mutex_unlock(&instance->mutex);
+    return running;
+}
+
+// ============================================================================
+// Records
+// ============================================================================
+
+void* furi_record_open(const char* name) {
+    UNUSED(name);
+    static char record;  // Any non-NULL handle, nothing is behind it
+    return &record;
+}
+
+void furi_record_close(const char* name) {
+    UNUSED(name);
+}
+
+// ============================================================================
+// Hardware
+// ============================================================================
+
+uint32_t furi_hal_random_get(void) {
+    // splitmix32 over the clock, good enough for a seed
+    static uint32_t state;
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    uint32_t z = (state += 0x9E3779B9u) ^ (uint32_t)ts.tv_nsec;
+    z = (z ^ (z >> 16)) * 0x85EBCA6Bu;
+    z = (z ^ (z >> 13)) * 0xC2B2AE35u;
+    return z ^ (z >> 16);
+}
@@ -0,0 +1,83 @@
+// Generates hirn_book_data.c: the unlimited hint answers for the first two turns
+// of every valid variant, see hirn_variant_valid.
+// Usage: gen_book > ../hirn_book_data.c
+
+#include <furi.h>
+
+#include "hirn_book.h"
+#include "hirn_solver.h"
+
+#define MAX_VARIANTS (HIRN_SHAPE_SLOTS * 2)
+
+static uint16_t search(const HirnCandidates* candidates) {
+    HirnSolverControl control;
+    atomic_init(&control.stop, false);
+    atomic_init(&control.progress, 0);
+    HirnHint hint;
+    if(!hirn_solver_search(candidates, &control, HIRN_SOLVER_UNLIMITED, &hint)) return HIRN_BOOK_NONE;
+    return hint.guess;
+}
+
+static void table_name(char* name, size_t size, HirnVariant variant) {
+    snprintf(name, size, "book_%d_%d_%s", variant.pegs, variant.colors, variant.repeat ? "repeat" : "unique");
+}
+
+int main(void) {
+    HirnVariant variants[MAX_VARIANTS];
+    uint16_t first[MAX_VARIANTS];
+    int count = 0;
+    char name[32];
+
+    printf("// Generated by host/gen_book, do not edit. Regenerate with: make -C host book\n\n");
+    printf("#include \"hirn_book.h\"\n\n");
+    for(int pegs = HIRN_MIN_PEGS; pegs <= HIRN_MAX_PEGS; pegs++) {
+        for(int colors = HIRN_MIN_COLORS; colors <= HIRN_MAX_COLORS; colors++) {
+            for(int repeat = 0; repeat < 2; repeat++) {
+                HirnVariant variant = {.pegs = pegs, .colors = colors, .repeat = repeat};
+                if(!hirn_variant_valid(variant)) continue;
+
+                HirnCandidates start = {0};
+                HirnCandidates candidates = {0};
+                hirn_candidates_reset(&start, variant);
+                uint16_t opening_index = search(&start);
+                HirnCode opening = hirn_code_from_index(opening_index, variant);
+                variants[count] = variant;
+                first[count] = opening_index;
+                count++;
+
+                table_name(name, sizeof(name), variant);
+                printf("// %dx%d %s repetition, opening guess %u\n", pegs, colors, repeat ? "with" : "without",
+                       opening_index);
+                printf("static const uint16_t %s[HIRN_FEEDBACK_CLASSES(%d)] = {\n", name, pegs);
+                for(int feedback = 0; feedback < HIRN_FEEDBACK_CLASSES(pegs); feedback++) {
+                    hirn_candidates_copy(&candidates, &start);
+                    hirn_candidates_filter(&candidates, opening, feedback);
+                    uint16_t second = candidates.count ? search(&candidates) : HIRN_BOOK_NONE;
+                    int black = hirn_feedback_blacks(feedback, pegs);
+                    int white = hirn_feedback_whites(feedback, pegs);
+                    if(second == HIRN_BOOK_NONE) {
+                        printf("    HIRN_BOOK_NONE, // %d black, %d white: no candidates\n", black, white);
+                    } else {
+                        printf("    %u, // %d black, %d white: %u candidates\n", second, black, white,
+                               candidates.count);
+                    }
+                }
+                printf("};\n\n");
+                hirn_candidates_free(&start);
+                hirn_candidates_free(&candidates);
+                fprintf(stderr, "%dx%d %s: opening %u\n", pegs, colors, repeat ? "repeat" : "unique",
+                        opening_index);
+            }
+        }
+    }
+
+    printf("const HirnBookEntry hirn_book[] = {\n");
+    for(int v = 0; v < count; v++) {
+        table_name(name, sizeof(name), variants[v]);
+        printf("    {%d, %d, %s, %u, %s},\n", variants[v].pegs, variants[v].colors,
+               variants[v].repeat ? "true" : "false", first[v], name);
+    }
+    printf("};\n\n");
+    printf("const uint32_t hirn_book_size = sizeof(hirn_book) / sizeof(hirn_book[0]);\n");
+    return 0;
+}
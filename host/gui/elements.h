@@ -0,0 +1,6 @@
+#pragma once
+
+#include <gui/gui.h>
+
+// Button with the OK icon at the bottom center, as in the firmware
+void elements_button_center(Canvas* canvas, const char* str);
@@ -0,0 +1,109 @@
+#pragma once
+
+// ============================================================================
+// Stand-in for the Flipper GUI headers: the canvas, drawing into a 128x64
+// 1-bit framebuffer in memory, and view ports that nothing draws, see
+// canvas_host.c.
+// ============================================================================
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef enum {
+    ColorWhite = 0x00,
+    ColorBlack = 0x01,
+    ColorXOR = 0x02,
+} Color;
+
+typedef enum {
+    FontPrimary,
+    FontSecondary,
+} Font;
+
+typedef enum {
+    AlignLeft,
+    AlignRight,
+    AlignTop,
+    AlignBottom,
+    AlignCenter,
+} Align;
+
+// XBM image, as the firmware's asset packer makes them from images/*.png
+typedef struct {
+    uint8_t width;
+    uint8_t height;
+    const uint8_t* data;
+} Icon;
+
+typedef struct Canvas Canvas;
+
+void canvas_clear(Canvas* canvas);
+void canvas_set_color(Canvas* canvas, Color color);
+void canvas_invert_color(Canvas* canvas);
+void canvas_set_font(Canvas* canvas, Font font);
+size_t canvas_width(const Canvas* canvas);
+size_t canvas_height(const Canvas* canvas);
+size_t canvas_current_font_height(const Canvas* canvas);
+
+// Framebuffer in the display's page layout: 8 pages of 128 columns, one
+// byte per column and page, bit 0 the top row
+uint8_t* canvas_get_buffer(Canvas* canvas);
+size_t canvas_get_buffer_size(const Canvas* canvas);
+
+void canvas_draw_dot(Canvas* canvas, int32_t x, int32_t y);
+void canvas_draw_line(Canvas* canvas, int32_t x1, int32_t y1, int32_t x2, int32_t y2);
+void canvas_draw_box(Canvas* canvas, int32_t x, int32_t y, size_t width, size_t height);
+void canvas_draw_frame(Canvas* canvas, int32_t x, int32_t y, size_t width, size_t height);
+void canvas_draw_rframe(Canvas* canvas, int32_t x, int32_t y, size_t width, size_t height, size_t radius);
+void canvas_draw_circle(Canvas* canvas, int32_t x, int32_t y, size_t radius);
+void canvas_draw_disc(Canvas* canvas, int32_t x, int32_t y, size_t radius);
+void canvas_draw_xbm(Canvas* canvas, int32_t x, int32_t y, size_t width, size_t height, const uint8_t* bitmap);
+void canvas_draw_icon(Canvas* canvas, int32_t x, int32_t y, const Icon* icon);
+
+void canvas_draw_str(Canvas* canvas, int32_t x, int32_t y, const char* str);
+void canvas_draw_str_aligned(Canvas* canvas, int32_t x, int32_t y, Align horizontal, Align vertical, const char* str);
+uint16_t canvas_string_width(Canvas* canvas, const char* str);
+
+// ============================================================================
+// View ports
+// ============================================================================
+
+#include <input/input.h>
+
+typedef struct ViewPort ViewPort;
+typedef struct Gui Gui;
+
+typedef enum {
+    GuiLayerFullscreen,
+} GuiLayer;
+
+#define RECORD_GUI "gui"
+
+typedef void (*ViewPortDrawCallback)(Canvas* canvas, void* context);
+typedef void (*ViewPortInputCallback)(InputEvent* event, void* context);
+
+ViewPort* view_port_alloc(void);
+void view_port_free(ViewPort* view_port);
+void view_port_draw_callback_set(ViewPort* view_port, ViewPortDrawCallback callback, void* context);
+void view_port_input_callback_set(ViewPort* view_port, ViewPortInputCallback callback, void* context);
+void view_port_update(ViewPort* view_port);
+void gui_add_view_port(Gui* gui, ViewPort* view_port, GuiLayer layer);
+void gui_remove_view_port(Gui* gui, ViewPort* view_port);
+
+// ============================================================================
+// Host only
+// ============================================================================
+
+Canvas* canvas_host_alloc(void);
+void canvas_host_free(Canvas* canvas);
+
+// Pixel (x, y), true for black
+bool canvas_host_get_pixel(const Canvas* canvas, int32_t x, int32_t y);
+
+// Binary PBM (P4) of the screen. Returns false on I/O errors.
+bool canvas_host_write_pbm(const Canvas* canvas, const char* path);
+
+// Number of pixels that differ from a PBM written by canvas_host_write_pbm,
+// or -1 if the file can't be read
+int32_t canvas_host_diff_pbm(const Canvas* canvas, const char* path);
@@ -0,0 +1,998 @@
+// Host benchmarks for the hirn game core.
+// Usage: hirn_bench [name-filter]
+
+#include <furi.h>
+#include <math.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "hirn_game.h"
+#include "hirn_random.h"
+#include "hirn_code.h"
+#include "hirn_candidates.h"
+#include "hirn_solver.h"
+#include "hirn_partition.h"
+#include "hirn_book.h"
+#include "hirn_sprite.h"
+#include "hirn_snapshot.h"
+#include "hirn_profile.h"
+
+#define BENCH_SPACE 1296      // Code space of HIRN_VARIANT_CLASSIC, which the benchmarks run on
+#define EXHAUSTIVE_SPACE 1296  // Larger variants are verified on samples
+
+static volatile uint32_t sink;  // Keeps results alive under -O2
+
+// Variant under test, see select_variant
+static HirnVariant variant;
+static uint32_t code_space;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void random_guess(CodeBreakerState* state) {
+    state->current_guess = hirn_code_from_index(rand() % code_space, variant);
+}
+
+// Every code of the variant with repetition, in mixed-radix order
+static HirnCode all_codes[HIRN_MAX_CODE_SPACE];
+
+// Run the following verifications and benchmarks on v
+static void select_variant(HirnVariant v) {
+    variant = v;
+    code_space = hirn_code_space(v);
+    for(uint32_t index = 0; index < code_space; index++) {
+        all_codes[index] = hirn_code_from_index(index, v);
+    }
+}
+
+static bool is_possible_secret(HirnCode code) {
+    return variant.repeat || hirn_code_is_repetition_free(code, variant.pegs);
+}
+
+// Every step-th code, so that a sweep over a large variant costs about as
+// much as one over the classic game
+static uint32_t sample_step(void) {
+    return code_space > EXHAUSTIVE_SPACE ? code_space / 251 : 1;
+}
+
+// Games to play in the per-game checks, fewer for large variants
+static int games_for(int games) {
+    int scaled = games * EXHAUSTIVE_SPACE / (int)code_space;
+    if(scaled > games) scaled = games;
+    return scaled > 2 ? scaled : 2;
+}
+
+// The original two-pass evaluate_guess scoring, kept as the reference
+static HirnScore reference_score(const PegColor* secret, const PegColor* guess) {
+    const int pegs = variant.pegs;
+    bool secret_used[HIRN_MAX_PEGS] = {false};
+    bool guess_used[HIRN_MAX_PEGS] = {false};
+    int black = 0;
+    int white = 0;
+    for(int i = 0; i < pegs; i++) {
+        if(guess[i] == secret[i]) {
+            black++;
+            secret_used[i] = true;
+            guess_used[i] = true;
+        }
+    }
+    for(int i = 0; i < pegs; i++) {
+        if(!guess_used[i]) {
+            for(int j = 0; j < pegs; j++) {
+                if(!secret_used[j] && guess[i] == secret[j]) {
+                    white++;
+                    secret_used[j] = true;
+                    break;
+                }
+            }
+        }
+    }
+    return HIRN_SCORE(black, white);
+}
+
+// ============================================================================
+// Verification
+// ============================================================================
+
+// Packed scoring must match the reference on every pair of codes, or every
+// guess against a sample of secrets
+static uint32_t verify_scoring(void) {
+    uint32_t mismatches = 0;
+    for(uint32_t s = 0; s < code_space; s += sample_step()) {
+        PegColor secret[HIRN_MAX_PEGS];
+        hirn_code_unpack(all_codes[s], secret, variant.pegs);
+        for(uint32_t g = 0; g < code_space; g++) {
+            PegColor guess[HIRN_MAX_PEGS];
+            hirn_code_unpack(all_codes[g], guess, variant.pegs);
+            if(hirn_score(all_codes[s], all_codes[g], variant.pegs) != reference_score(secret, guess)) {
+                if(mismatches++ < 8) {
+                    printf("score mismatch: secret %06lx guess %06lx\n",
+                           (unsigned long)all_codes[s], (unsigned long)all_codes[g]);
+                }
+            }
+        }
+    }
+    return mismatches;
+}
+
+// Code indices round-trip and enumerate every complete code once, the
+// packed form is only as wide as the pegs
+static uint32_t verify_code_index(void) {
+    uint32_t mismatches = 0;
+    for(uint32_t index = 0; index < code_space; index++) {
+        HirnCode code = all_codes[index];
+        if(!hirn_code_is_complete(code, variant.pegs) || hirn_code_index(code, variant) != index) mismatches++;
+        if(code & ~hirn_code_mask(variant.pegs)) mismatches++;
+        if(index > 0 && code == all_codes[index - 1]) mismatches++;
+    }
+    if(hirn_code_is_complete(all_codes[0] & ~0x0Fu, variant.pegs)) mismatches++;
+    return mismatches;
+}
+
+// Ranks number the possible secrets densely in index order and unrank back
+static uint32_t verify_code_rank(void) {
+    uint32_t mismatches = 0;
+    uint32_t rank = 0;
+    for(uint32_t index = 0; index < code_space; index++) {
+        HirnCode code = all_codes[index];
+        if(!is_possible_secret(code)) continue;
+        if(hirn_code_rank(code, variant) != rank || hirn_code_unrank(rank, variant) != code) {
+            if(mismatches++ < 8) {
+                printf("rank mismatch: code %06lx rank %lu\n", (unsigned long)code, (unsigned long)rank);
+            }
+        }
+        rank++;
+    }
+    if(rank != hirn_code_rank_space(variant)) mismatches++;
+    return mismatches;
+}
+
+// Every reachable score maps to a class that decodes back to it
+static uint32_t verify_feedback_classes(void) {
+    bool seen[HIRN_MAX_FEEDBACK_CLASSES] = {false};
+    uint32_t mismatches = 0;
+    for(uint32_t s = 0; s < code_space; s += sample_step()) {
+        for(uint32_t g = 0; g < code_space; g++) {
+            HirnScore score = hirn_score(all_codes[s], all_codes[g], variant.pegs);
+            FeedbackClass feedback = hirn_feedback_class(score, variant.pegs);
+            if(feedback >= HIRN_FEEDBACK_CLASSES(variant.pegs) || hirn_feedback_score(feedback, variant.pegs) != score) {
+                mismatches++;
+                continue;
+            }
+            seen[feedback] = true;
+        }
+    }
+    for(int i = 0; i < HIRN_FEEDBACK_CLASSES(variant.pegs); i++) {
+        if(!seen[i]) mismatches++;
+    }
+    if(hirn_feedback_blacks(HIRN_FEEDBACK_WIN(variant.pegs), variant.pegs) != variant.pegs) mismatches++;
+    return mismatches;
+}
+
+// Reference output of xoshiro128**, then every secret must be valid and all
+// of them about equally likely (chi-square well inside the expected spread)
+static uint32_t verify_random(void) {
+    uint32_t mismatches = 0;
+    HirnRandom random = {.s = {1, 2, 3, 4}};
+    if(hirn_random_next(&random) != 11520 || hirn_random_next(&random) != 0) mismatches++;
+
+    static uint32_t counts[HIRN_MAX_CODE_SPACE];
+    const uint32_t draws = 1000000;
+    memset(counts, 0, sizeof(counts));
+    hirn_random_seed(&random, 418);
+    for(uint32_t n = 0; n < draws; n++) {
+        uint16_t index = hirn_random_code_index(&random, variant);
+        if(index >= code_space || !is_possible_secret(all_codes[index])) {
+            mismatches++;
+            continue;
+        }
+        counts[index]++;
+    }
+    uint32_t codes = 0;
+    for(uint32_t index = 0; index < code_space; index++) {
+        codes += is_possible_secret(all_codes[index]);
+    }
+    double expected = (double)draws / codes, chi2 = 0;
+    for(uint32_t index = 0; index < code_space; index++) {
+        if(!is_possible_secret(all_codes[index])) continue;
+        double d = counts[index] - expected;
+        chi2 += d * d / expected;
+    }
+    // Mean codes - 1, standard deviation about sqrt(2 * codes)
+    if(chi2 > codes + 6 * sqrt(2.0 * codes)) {
+        printf("random: %lu codes, chi2 %.0f\n", (unsigned long)codes, chi2);
+        mismatches++;
+    }
+    return mismatches;
+}
+
+// Incremental filtering must match a from-scratch check of the whole history
+static uint32_t verify_candidates(CodeBreakerState* state) {
+    HirnCandidates candidates = {0};
+    uint32_t mismatches = 0;
+    for(int game = 0; game < games_for(200); game++) {
+        reset_game_state(state, variant);
+        hirn_candidates_reset(&candidates, variant);
+        while(state->state == STATE_PLAYING) {
+            random_guess(state);
+            if(!is_guess_different(state)) continue;
+            evaluate_guess(state);
+            int last = state->attempts_used - 1;
+            hirn_candidates_filter(&candidates, all_codes[state->guess_history[last]], state->feedback_history[last]);
+
+            uint16_t count = 0;
+            for(uint32_t index = 0; index < code_space; index++) {
+                bool consistent = is_possible_secret(all_codes[index]);
+                for(int i = 0; i < state->attempts_used && consistent; i++) {
+                    HirnScore score = hirn_score(all_codes[index], all_codes[state->guess_history[i]], variant.pegs);
+                    consistent = hirn_feedback_class(score, variant.pegs) == state->feedback_history[i];
+                }
+                count += consistent;
+                if(consistent != hirn_candidates_contains(&candidates, index)) mismatches++;
+            }
+            if(count != candidates.count) mismatches++;
+            if(!hirn_candidates_contains(&candidates, hirn_code_index(state->secret_code, variant))) mismatches++;
+        }
+        // Bits for this variant's code space, no more
+        if(candidates.words != (code_space + 31) / 32) mismatches++;
+    }
+    hirn_candidates_free(&candidates);
+    return mismatches;
+}
+
+// Attempt of the history the complete code contradicts: the first one, or -1
+static int reference_conflict(const CodeBreakerState* state, HirnCode code) {
+    for(int i = 0; i < state->attempts_used; i++) {
+        HirnScore score = hirn_score(code, all_codes[state->guess_history[i]], variant.pegs);
+        if(hirn_feedback_class(score, variant.pegs) != state->feedback_history[i]) return i;
+    }
+    return -1;
+}
+
+// Complete guesses must match a full rescore, partial ones must never flag a
+// guess that some filling of its empty pegs makes consistent
+static uint32_t verify_conflicts(CodeBreakerState* state) {
+    uint32_t mismatches = 0;
+    for(int game = 0; game < games_for(200); game++) {
+        reset_game_state(state, variant);
+        while(state->state == STATE_PLAYING) {
+            random_guess(state);
+            if(!is_guess_different(state)) continue;
+            evaluate_guess(state);
+
+            // Complete guess
+            HirnCode guess = all_codes[rand() % code_space];
+            state->current_guess = guess;
+            if(find_conflicting_attempt(state) != reference_conflict(state, guess)) mismatches++;
+
+            // Same guess with random pegs cleared
+            HirnCode partial = guess;
+            for(int i = 0; i < variant.pegs; i++) {
+                if(rand() & 1) partial = hirn_code_set(partial, i, COLOR_NONE);
+            }
+            state->current_guess = partial;
+            int conflict = find_conflicting_attempt(state);
+            bool fillable = false;
+            for(uint32_t index = 0; index < code_space && !fillable; index++) {
+                HirnCode code = all_codes[index];
+                bool fits = true;
+                for(int i = 0; i < variant.pegs; i++) {
+                    PegColor color = hirn_code_get(partial, i);
+                    if(color != COLOR_NONE && color != hirn_code_get(code, i)) fits = false;
+                }
+                fillable = fits && reference_conflict(state, code) < 0;
+            }
+            if(fillable && conflict >= 0) mismatches++;
+        }
+    }
+    state->current_guess = 0;
+    return mismatches;
+}
+
+static void plot_pixel(uint8_t* bits, int radius, int x, int y) {
+    bits[y * HIRN_SPRITE_STRIDE(radius) + x / 8] |= 1u << (x % 8);
+}
+
+// The patterns as draw_peg drew them dot by dot and line by line, on top of
+// the sprite's circle outline
+static void reference_sprite(uint8_t* bits, PegColor color, int radius) {
+    if(color == COLOR_RED) {
+        hirn_sprite_rasterize(bits, COLOR_RED, radius);
+        return;
+    }
+    hirn_sprite_rasterize(bits, COLOR_NONE, radius);
+    int c = radius;
+    if(color == COLOR_CYAN) {
+        for(int i = -radius + 2; i <= radius - 2; i += 3) {
+            for(int j = -radius + 2; j <= radius - 2; j += 3) {
+                if(abs(j) < (int)sqrt(radius * radius - i * i)) plot_pixel(bits, radius, c + j, c + i);
+            }
+        }
+        return;
+    }
+    if(color == COLOR_PINK) {
+        // The outline of a sprite half the size, centered
+        int inner = radius / 2;
+        uint8_t ring[HIRN_SPRITE_BYTES];
+        hirn_sprite_rasterize(ring, COLOR_NONE, inner);
+        for(int y = 0; y < HIRN_SPRITE_SIZE(inner); y++) {
+            for(int x = 0; x < HIRN_SPRITE_SIZE(inner); x++) {
+                if(ring[y * HIRN_SPRITE_STRIDE(inner) + x / 8] & (1u << (x % 8))) {
+                    plot_pixel(bits, radius, c - inner + x, c - inner + y);
+                }
+            }
+        }
+        return;
+    }
+    for(int i = -radius; i <= radius; i += 3) {
+        int half = (int)sqrt(radius * radius - i * i);
+        for(int k = -half; k <= half; k++) {
+            if(color == COLOR_GREEN || color == COLOR_ORANGE) plot_pixel(bits, radius, c + k, c + i);
+            if(color == COLOR_BLUE || color == COLOR_ORANGE) plot_pixel(bits, radius, c + i, c + k);
+        }
+    }
+    if(color == COLOR_YELLOW || color == COLOR_PURPLE) {
+        for(int offset = -radius * 2; offset <= radius * 2; offset += 4) {
+            for(int i = -radius; i <= radius; i++) {
+                int j = (color == COLOR_YELLOW ? i : -i) + offset;
+                if(i * i + j * j <= radius * radius) plot_pixel(bits, radius, c + i, c - j);
+            }
+        }
+    }
+}
+
+// Spans must match the libm ones, every sprite must match the old drawing, and the cache must hand out the
+// right sprite across radius changes
+static bool verify_sprites(void) {
+    uint32_t mismatches = 0;
+    uint8_t expected[HIRN_SPRITE_BYTES], actual[HIRN_SPRITE_BYTES];
+    for(int radius = 0; radius <= HIRN_SPRITE_MAX_RADIUS; radius++) {
+        uint8_t spans[HIRN_SPRITE_MAX_RADIUS + 1];
+        hirn_circle_spans(radius, spans);
+        for(int d = 0; d <= radius; d++) {
+            if(spans[d] != (int)sqrt(radius * radius - d * d)) mismatches++;
+        }
+    }
+    for(int radius = 1; radius <= HIRN_SPRITE_MAX_RADIUS; radius++) {
+        int bytes = HIRN_SPRITE_STRIDE(radius) * HIRN_SPRITE_SIZE(radius);
+        for(int color = COLOR_NONE; color <= HIRN_MAX_COLORS; color++) {
+            memset(expected, 0, sizeof(expected));
+            reference_sprite(expected, color, radius);
+            hirn_sprite_rasterize(actual, color, radius);
+            if(memcmp(expected, actual, bytes)) mismatches++;
+        }
+    }
+
+    static HirnSpriteCache cache;
+    hirn_sprite_cache_reset(&cache);
+    const int radii[] = {8, 6, 8, 3, 6, 8, 6};
+    for(int step = 0; step < 7; step++) {
+        int radius = radii[step];
+        for(int color = COLOR_NONE; color <= HIRN_MAX_COLORS; color++) {
+            hirn_sprite_rasterize(expected, color, radius);
+            const uint8_t* cached = hirn_sprite_get(&cache, color, radius);
+            if(memcmp(expected, cached, HIRN_SPRITE_STRIDE(radius) * HIRN_SPRITE_SIZE(radius))) mismatches++;
+        }
+    }
+    printf("verify sprites: %lu mismatches\n", (unsigned long)mismatches);
+    return mismatches == 0;
+}
+
+// Render state whose every field follows from n, so a torn copy shows
+static void fill_render(HirnRenderState* render, uint32_t n) {
+    memset(render, 0, sizeof(HirnRenderState));
+    render->state.start_time = n;
+    render->state.elapsed_time = ~n;
+    render->state.secret_code = n * 3;
+    render->state.current_guess = n * 5;
+    for(int i = 0; i < MAX_ATTEMPTS; i++) {
+        render->state.guess_history[i] = n + i;
+        render->state.feedback_history[i] = n - i;
+    }
+    render->state.attempts_used = n;
+    render->candidates = n >> 16;
+    render->conflict = n >> 8;
+    render->last_hint.evaluated = n;
+}
+
+typedef struct {
+    HirnSnapshot snapshot;
+    atomic_bool stop;
+    uint32_t published;
+} SnapshotStress;
+
+static void* snapshot_writer(void* ctx) {
+    SnapshotStress* stress = ctx;
+    HirnRenderState render;
+    uint32_t n = 0;
+    while(!atomic_load_explicit(&stress->stop, memory_order_relaxed)) {
+        fill_render(&render, ++n);
+        hirn_snapshot_publish(&stress->snapshot, &render);
+    }
+    stress->published = n;
+    return NULL;
+}
+
+// Two threads: one publishes as fast as it can, the other must only ever see
+// whole snapshots, never older than the last one it saw
+static bool verify_snapshot(void) {
+    static SnapshotStress stress;
+    memset(&stress, 0, sizeof(stress));
+    HirnRenderState first;
+    fill_render(&first, 0);
+    hirn_snapshot_publish(&stress.snapshot, &first);
+
+    pthread_t writer;
+    pthread_create(&writer, NULL, snapshot_writer, &stress);
+    uint32_t reads = 0, torn = 0, stale = 0, last = 0;
+    uint64_t end = now_ns() + 300000000ull;
+    while(now_ns() < end) {
+        for(int i = 0; i < 1000; i++) {
+            HirnRenderState render, expected;
+            hirn_snapshot_read(&stress.snapshot, &render);
+            uint32_t n = render.state.start_time;
+            fill_render(&expected, n);
+            if(memcmp(&render, &expected, sizeof(HirnRenderState))) torn++;
+            if(n < last) stale++;
+            last = n;
+            reads++;
+        }
+    }
+    atomic_store(&stress.stop, true);
+    pthread_join(writer, NULL);
+    printf("verify snapshot: %lu reads, %lu publishes, %lu torn, %lu stale\n", (unsigned long)reads,
+           (unsigned long)stress.published, (unsigned long)torn, (unsigned long)stale);
+    return torn == 0 && stale == 0;
+}
+
+// Largest partition for guess, counted without any pruning
+static int reference_worst_partition(const HirnCandidates* candidates, HirnCode guess) {
+    int partitions[HIRN_MAX_FEEDBACK_CLASSES] = {0};
+    int worst = 0;
+    for(uint32_t index = 0; index < code_space; index++) {
+        if(!candidates->bits[index / 32]) {
+            index |= 31;  // Skip the empty word
+            continue;
+        }
+        if(!hirn_candidates_contains(candidates, index)) continue;
+        int size = ++partitions[hirn_feedback_class(hirn_score(all_codes[index], guess, variant.pegs), variant.pegs)];
+        if(size > worst) worst = size;
+    }
+    return worst;
+}
+
+// Plain Knuth minimax with the same tie-breaks as the solver
+static uint16_t reference_minimax(const HirnCandidates* candidates) {
+    int best_worst = code_space + 1;
+    bool best_is_candidate = false;
+    uint16_t best_index = 0;
+    for(uint32_t index = 0; index < code_space; index++) {
+        int worst = reference_worst_partition(candidates, all_codes[index]);
+        bool is_candidate = hirn_candidates_contains(candidates, index);
+        if(worst < best_worst || (worst == best_worst && is_candidate && !best_is_candidate)) {
+            best_worst = worst;
+            best_is_candidate = is_candidate;
+            best_index = index;
+        }
+    }
+    return best_index;
+}
+
+
+static void init_control(HirnSolverControl* control) {
+    atomic_init(&control->stop, false);
+    atomic_init(&control->progress, 0);
+}
+
+// The pruned, candidates-first search must pick the reference guess. On 4x6
+// with repetition the opening is Knuth's 1122, which in index order comes out
+// as 2211. Large variants play random guesses until the reference search is
+// as cheap as on the classic game, their sampled search on the full set only
+// has to give a valid answer. Complete searches score every code once, which
+// is where progress ends. A stopped search still answers with a candidate.
+static uint32_t verify_solver(CodeBreakerState* state) {
+    HirnCandidates candidates = {0};
+    HirnSolverControl control;
+    HirnHint hint;
+    init_control(&control);
+    uint32_t mismatches = 0;
+
+    if(hirn_variant_equal(variant, (HirnVariant){.pegs = 4, .colors = 6, .repeat = true})) {
+        hirn_candidates_reset(&candidates, variant);
+        const PegColor knuth[] = {COLOR_GREEN, COLOR_GREEN, COLOR_RED, COLOR_RED};
+        if(!hirn_solver_search(&candidates, &control, HIRN_SOLVER_UNLIMITED, &hint) ||
+           hint.guess != hirn_code_index(hirn_code_pack(knuth, 4), variant) || hint.worst != 256 || !hint.complete) {
+            mismatches++;
+        }
+        if(reference_worst_partition(&candidates, all_codes[hint.guess]) != 256) mismatches++;
+    }
+
+    if(code_space > EXHAUSTIVE_SPACE) {
+        hirn_candidates_reset(&candidates, variant);
+        if(!hirn_solver_search(&candidates, &control, 20, &hint) || hint.guess >= code_space) mismatches++;
+        // Sampled only with more candidates than the classic game has codes
+        if(candidates.count > BENCH_SPACE) {
+            if(!hirn_solver_search(&candidates, &control, HIRN_SOLVER_UNLIMITED, &hint) || !hint.complete ||
+               hint.evaluated != code_space || atomic_load(&control.progress) != code_space) {
+                mismatches++;
+            }
+        }
+    }
+
+    int games = hirn_variant_equal(variant, HIRN_VARIANT_CLASSIC) ? 10 : 2;
+    for(int game = 0; game < games; game++) {
+        reset_game_state(state, variant);
+        hirn_candidates_reset(&candidates, variant);
+        while(state->state == STATE_PLAYING && candidates.count > 1) {
+            if((uint64_t)candidates.count * code_space > BENCH_SPACE * BENCH_SPACE) {
+                random_guess(state);
+            } else {
+                if(!hirn_solver_search(&candidates, &control, HIRN_SOLVER_UNLIMITED, &hint)) mismatches++;
+                if(hint.guess != reference_minimax(&candidates) || !hint.complete) mismatches++;
+                if(candidates.count > 2 && hint.evaluated != code_space) mismatches++;
+                state->current_guess = all_codes[hint.guess];
+            }
+            if(!is_guess_different(state)) continue;
+            evaluate_guess(state);
+            int last = state->attempts_used - 1;
+            hirn_candidates_filter(&candidates, all_codes[state->guess_history[last]], state->feedback_history[last]);
+        }
+    }
+
+    hirn_candidates_reset(&candidates, variant);
+    atomic_store(&control.stop, true);
+    if(!hirn_solver_search(&candidates, &control, HIRN_SOLVER_UNLIMITED, &hint) || hint.complete ||
+       hint.evaluated != 0 || !hirn_candidates_contains(&candidates, hint.guess)) {
+        mismatches++;
+    }
+    hirn_candidates_free(&candidates);
+    return mismatches;
+}
+
+// Largest partition of the codes at indices, counted in their order until
+// one reaches limit
+static uint16_t reference_worst(const uint16_t* indices, uint16_t count, HirnCode guess, uint32_t limit) {
+    uint16_t partitions[HIRN_MAX_FEEDBACK_CLASSES] = {0};
+    uint16_t worst = 0;
+    for(uint16_t i = 0; i < count && worst < limit; i++) {
+        uint16_t size = ++partitions[hirn_feedback_class(hirn_score(all_codes[indices[i]], guess, variant.pegs), variant.pegs)];
+        if(size > worst) worst = size;
+    }
+    return worst;
+}
+
+// Both partition methods must count what scoring every candidate one by one
+// counts, on the full set and on sets filtered by random games, and stop at
+// the same code for a limit
+static uint32_t verify_partition(CodeBreakerState* state) {
+    static uint16_t indices[HIRN_MAX_CODE_SPACE];
+    HirnCandidates candidates = {0};
+    HirnPartitionSet sets[2] = {0};
+    uint32_t mismatches = 0;
+    for(int game = 0; game < games_for(20); game++) {
+        reset_game_state(state, variant);
+        hirn_candidates_reset(&candidates, variant);
+        while(state->state == STATE_PLAYING) {
+            uint16_t count = 0;
+            for(uint32_t index = 0; index < code_space; index++) {
+                if(hirn_candidates_contains(&candidates, index)) indices[count++] = index;
+            }
+            for(int method = HirnPartitionScalar; method <= HirnPartitionSimd; method++) {
+                hirn_partition_set_fill(&sets[method], indices, count, variant, method);
+            }
+            for(int trial = 0; trial < 4; trial++) {
+                HirnCode guess = all_codes[rand() % code_space];
+                uint16_t expected[HIRN_MAX_FEEDBACK_CLASSES] = {0};
+                for(uint16_t i = 0; i < count; i++) {
+                    expected[hirn_feedback_class(hirn_score(all_codes[indices[i]], guess, variant.pegs), variant.pegs)]++;
+                }
+                uint32_t limit = 1 + rand() % (count + 1);
+                uint16_t worst = reference_worst(indices, count, guess, limit);
+                for(int method = HirnPartitionScalar; method <= HirnPartitionSimd; method++) {
+                    uint16_t partitions[HIRN_MAX_FEEDBACK_CLASSES];
+                    hirn_partition_histogram(&sets[method], guess, partitions);
+                    size_t size = HIRN_FEEDBACK_CLASSES(variant.pegs) * sizeof(uint16_t);
+                    if(memcmp(partitions, expected, size) || hirn_partition_worst(&sets[method], guess, limit) != worst) {
+                        if(mismatches++ < 8) {
+                            printf("partition mismatch: method %d guess %06lx, %u candidates\n",
+                                   method, (unsigned long)guess, count);
+                        }
+                    }
+                }
+            }
+            random_guess(state);
+            if(!is_guess_different(state)) continue;
+            evaluate_guess(state);
+            int last = state->attempts_used - 1;
+            hirn_candidates_filter(&candidates, all_codes[state->guess_history[last]], state->feedback_history[last]);
+        }
+    }
+    hirn_partition_set_free(&sets[HirnPartitionScalar]);
+    hirn_partition_set_free(&sets[HirnPartitionSimd]);
+    hirn_candidates_free(&candidates);
+    return mismatches;
+}
+
+// The book must give the same answers as an unlimited live search. Large
+// variants only check the opening, their second turns take seconds each.
+static uint32_t verify_book(CodeBreakerState* state) {
+    HirnCandidates start = {0};
+    HirnCandidates candidates = {0};
+    HirnSolverControl control;
+    HirnHint hint;
+    init_control(&control);
+    uint32_t mismatches = 0;
+    uint16_t guess;
+
+    reset_game_state(state, variant);
+    hirn_candidates_reset(&start, variant);
+    hirn_solver_search(&start, &control, HIRN_SOLVER_UNLIMITED, &hint);
+    if(!hirn_book_lookup(state, &guess) || guess != hint.guess) mismatches++;
+    uint16_t first = hint.guess;
+
+    int classes = code_space > EXHAUSTIVE_SPACE ? 0 : HIRN_FEEDBACK_CLASSES(variant.pegs);
+    for(int feedback = 0; feedback < classes; feedback++) {
+        hirn_candidates_copy(&candidates, &start);
+        hirn_candidates_filter(&candidates, all_codes[first], feedback);
+        state->attempts_used = 1;
+        state->guess_history[0] = first;
+        state->feedback_history[0] = feedback;
+        bool found = hirn_book_lookup(state, &guess);
+        if(candidates.count == 0) {
+            if(found) mismatches++;
+            continue;
+        }
+        hirn_solver_search(&candidates, &control, HIRN_SOLVER_UNLIMITED, &hint);
+        if(!found || guess != hint.guess) mismatches++;
+    }
+
+    // Off-book openings and later turns fall back to the live search
+    state->attempts_used = 1;
+    state->guess_history[0] = (first + 1) % code_space;
+    if(hirn_book_lookup(state, &guess)) mismatches++;
+    state->attempts_used = 2;
+    state->guess_history[0] = first;
+    if(hirn_book_lookup(state, &guess)) mismatches++;
+    hirn_candidates_free(&start);
+    hirn_candidates_free(&candidates);
+    return mismatches;
+}
+
+// Every check that depends on the variant, one line per variant
+static bool verify_variant(CodeBreakerState* state) {
+    uint32_t index = verify_code_index();
+    uint32_t rank = verify_code_rank();
+    uint32_t scoring = verify_scoring();
+    uint32_t feedback = verify_feedback_classes();
+    uint32_t random = verify_random();
+    uint32_t candidates = verify_candidates(state);
+    uint32_t conflicts = verify_conflicts(state);
+    uint32_t partition = verify_partition(state);
+    uint32_t solver = verify_solver(state);
+    uint32_t book = verify_book(state);
+    printf("verify %dx%d %-6s: %5lu codes%s, mismatches index %lu rank %lu scoring %lu feedback %lu random %lu "
+           "candidates %lu conflicts %lu partition %lu solver %lu book %lu\n",
+           variant.pegs, variant.colors, variant.repeat ? "repeat" : "unique", (unsigned long)code_space,
+           sample_step() > 1 ? " (sampled)" : "", (unsigned long)index, (unsigned long)rank, (unsigned long)scoring,
+           (unsigned long)feedback, (unsigned long)random, (unsigned long)candidates, (unsigned long)conflicts, (unsigned long)partition,
+           (unsigned long)solver, (unsigned long)book);
+    return index + rank + scoring + feedback + random + candidates + conflicts + partition + solver + book == 0;
+}
+
+// ============================================================================
+// Benchmarks
+// ============================================================================
+
+static void bench_generate_secret_code(CodeBreakerState* state, uint32_t iterations) {
+    for(uint32_t n = 0; n < iterations; n++) {
+        generate_secret_code(state);
+        sink += state->secret_code;
+    }
+}
+
+static void bench_reset_game_state(CodeBreakerState* state, uint32_t iterations) {
+    for(uint32_t n = 0; n < iterations; n++) {
+        reset_game_state(state, variant);
+        sink += state->secret_code;
+    }
+}
+
+static void bench_evaluate_guess(CodeBreakerState* state, uint32_t iterations) {
+    reset_game_state(state, variant);
+    random_guess(state);
+    for(uint32_t n = 0; n < iterations; n++) {
+        if(state->state != STATE_PLAYING) {
+            state->state = STATE_PLAYING;
+            state->attempts_used = 0;
+        }
+        evaluate_guess(state);
+        sink += state->feedback_history[state->attempts_used - 1];
+    }
+}
+
+static void bench_guess_checks(CodeBreakerState* state, uint32_t iterations) {
+    reset_game_state(state, variant);
+    random_guess(state);
+    evaluate_guess(state);
+    for(uint32_t n = 0; n < iterations; n++) {
+        state->current_guess = hirn_code_set(state->current_guess, n % variant.pegs, (n % variant.colors) + 1);
+        sink += is_guess_complete(state) + is_guess_different(state);
+    }
+}
+
+// All pairs of codes, iterations counts sweeps
+static void bench_score_reference(CodeBreakerState* state, uint32_t iterations) {
+    UNUSED(state);
+    static PegColor pegs[BENCH_SPACE][HIRN_MAX_PEGS];
+    for(int i = 0; i < BENCH_SPACE; i++) hirn_code_unpack(all_codes[i], pegs[i], variant.pegs);
+    for(uint32_t n = 0; n < iterations; n++) {
+        for(int s = 0; s < BENCH_SPACE; s++) {
+            for(int g = 0; g < BENCH_SPACE; g++) sink += reference_score(pegs[s], pegs[g]);
+        }
+    }
+}
+
+static void bench_score_packed(CodeBreakerState* state, uint32_t iterations) {
+    UNUSED(state);
+    for(uint32_t n = 0; n < iterations; n++) {
+        for(int s = 0; s < BENCH_SPACE; s++) {
+            for(int g = 0; g < BENCH_SPACE; g++) sink += hirn_score(all_codes[s], all_codes[g], 4);
+        }
+    }
+}
+
+// Solver-style inner loop: histograms computed once per code
+static void bench_score_histograms(CodeBreakerState* state, uint32_t iterations) {
+    UNUSED(state);
+    static uint32_t histograms[BENCH_SPACE];
+    for(int i = 0; i < BENCH_SPACE; i++) histograms[i] = hirn_code_histogram(all_codes[i], 4);
+    for(uint32_t n = 0; n < iterations; n++) {
+        for(int s = 0; s < BENCH_SPACE; s++) {
+            for(int g = 0; g < BENCH_SPACE; g++) {
+                sink += hirn_score_histograms(all_codes[s], histograms[s], all_codes[g], histograms[g], 4);
+            }
+        }
+    }
+}
+
+static void bench_candidates_reset(CodeBreakerState* state, uint32_t iterations) {
+    UNUSED(state);
+    HirnCandidates candidates = {0};
+    for(uint32_t n = 0; n < iterations; n++) {
+        hirn_candidates_reset(&candidates, variant);
+        sink += candidates.count;
+    }
+    hirn_candidates_free(&candidates);
+}
+
+// First filter step on a full set, the most expensive one of a game
+static void bench_candidates_filter(CodeBreakerState* state, uint32_t iterations) {
+    UNUSED(state);
+    HirnCandidates full = {0};
+    HirnCandidates candidates = {0};
+    hirn_candidates_reset(&full, variant);
+    for(uint32_t n = 0; n < iterations; n++) {
+        hirn_candidates_copy(&candidates, &full);
+        HirnCode guess = all_codes[n % code_space];
+        hirn_candidates_filter(
+            &candidates, guess, hirn_feedback_class(hirn_score(all_codes[0], guess, variant.pegs), variant.pegs));
+        sink += candidates.count;
+    }
+    hirn_candidates_free(&full);
+    hirn_candidates_free(&candidates);
+}
+
+// Partition histogram of a guess over every possible secret, unpacked once
+static void bench_partition(HirnPartitionMethod method, uint32_t iterations) {
+    static uint16_t indices[HIRN_MAX_CODE_SPACE];
+    HirnCandidates candidates = {0};
+    HirnPartitionSet set = {0};
+    hirn_candidates_reset(&candidates, variant);
+    uint16_t count = 0;
+    for(uint32_t index = 0; index < code_space; index++) {
+        if(hirn_candidates_contains(&candidates, index)) indices[count++] = index;
+    }
+    hirn_partition_set_fill(&set, indices, count, variant, method);
+    uint16_t partitions[HIRN_MAX_FEEDBACK_CLASSES];
+    for(uint32_t n = 0; n < iterations; n++) {
+        hirn_partition_histogram(&set, all_codes[n % code_space], partitions);
+        sink += partitions[0];
+    }
+    hirn_partition_set_free(&set);
+    hirn_candidates_free(&candidates);
+}
+
+static void bench_partition_scalar(CodeBreakerState* state, uint32_t iterations) {
+    UNUSED(state);
+    bench_partition(HirnPartitionScalar, iterations);
+}
+
+static void bench_partition_simd(CodeBreakerState* state, uint32_t iterations) {
+    UNUSED(state);
+    bench_partition(HirnPartitionSimd, iterations);
+}
+
+// Hint for the first turn, the largest search of a game
+static void bench_solver_first_hint(CodeBreakerState* state, uint32_t iterations) {
+    UNUSED(state);
+    HirnCandidates candidates = {0};
+    HirnSolverControl control;
+    HirnHint hint;
+    init_control(&control);
+    hirn_candidates_reset(&candidates, variant);
+    for(uint32_t n = 0; n < iterations; n++) {
+        hirn_solver_search(&candidates, &control, HIRN_SOLVER_UNLIMITED, &hint);
+        sink += hint.guess;
+    }
+    hirn_candidates_free(&candidates);
+}
+
+// Consistency check of a complete guess against a 10 attempt history
+static void bench_find_conflict(CodeBreakerState* state, uint32_t iterations) {
+    reset_game_state(state, variant);
+    for(int i = 0; i < 10; i++) {
+        state->guess_history[i] = rand() % code_space;
+        state->feedback_history[i] = hirn_feedback_class(
+            hirn_score(state->secret_code, all_codes[state->guess_history[i]], variant.pegs), variant.pegs);
+    }
+    state->attempts_used = 10;
+    for(uint32_t n = 0; n < iterations; n++) {
+        state->current_guess = all_codes[n % code_space];
+        sink += find_conflicting_attempt(state);
+    }
+}
+
+static void bench_random_code_index(CodeBreakerState* state, uint32_t iterations) {
+    UNUSED(state);
+    HirnRandom random;
+    hirn_random_seed(&random, 418);
+    for(uint32_t n = 0; n < iterations; n++) {
+        sink += hirn_random_code_index(&random, variant);
+    }
+}
+
+// Rank and unrank of every possible secret, one of each per op
+static void bench_code_rank(CodeBreakerState* state, uint32_t iterations) {
+    UNUSED(state);
+    uint32_t ranks = hirn_code_rank_space(variant);
+    for(uint32_t n = 0; n < iterations; n++) {
+        sink += hirn_code_rank(hirn_code_unrank(n % ranks, variant), variant);
+    }
+}
+
+// All patterns of the board's peg size
+static void bench_sprite_rasterize(CodeBreakerState* state, uint32_t iterations) {
+    UNUSED(state);
+    uint8_t bits[HIRN_SPRITE_BYTES];
+    for(uint32_t n = 0; n < iterations; n++) {
+        for(int color = COLOR_NONE; color <= HIRN_MAX_COLORS; color++) {
+            hirn_sprite_rasterize(bits, color, 8);
+            sink += bits[HIRN_SPRITE_BYTES / 2];
+        }
+    }
+}
+
+// Cache hits, what every peg of a frame costs once warmed up
+static void bench_sprite_get(CodeBreakerState* state, uint32_t iterations) {
+    UNUSED(state);
+    static HirnSpriteCache cache;
+    hirn_sprite_cache_reset(&cache);
+    for(uint32_t n = 0; n < iterations; n++) {
+        sink += hirn_sprite_get(&cache, n % (HIRN_MAX_COLORS + 1), n & 1 ? 8 : 6)[0];
+    }
+}
+
+static void bench_snapshot_publish(CodeBreakerState* state, uint32_t iterations) {
+    static HirnSnapshot snapshot;
+    HirnRenderState render = {.state = *state};
+    for(uint32_t n = 0; n < iterations; n++) {
+        render.candidates = n;
+        hirn_snapshot_publish(&snapshot, &render);
+    }
+    sink += atomic_load(&snapshot.sequence);
+}
+
+static void bench_snapshot_read(CodeBreakerState* state, uint32_t iterations) {
+    static HirnSnapshot snapshot;
+    HirnRenderState render = {.state = *state};
+    hirn_snapshot_publish(&snapshot, &render);
+    for(uint32_t n = 0; n < iterations; n++) {
+        hirn_snapshot_read(&snapshot, &render);
+        sink += render.candidates;
+    }
+}
+
+// One full game with random guesses until it is won or lost
+static void bench_random_game(CodeBreakerState* state, uint32_t iterations) {
+    for(uint32_t n = 0; n < iterations; n++) {
+        reset_game_state(state, variant);
+        while(state->state == STATE_PLAYING) {
+            random_guess(state);
+            if(is_guess_different(state)) evaluate_guess(state);
+        }
+        sink += state->attempts_used;
+    }
+}
+
+typedef struct {
+    const char* name;
+    void (*run)(CodeBreakerState* state, uint32_t iterations);
+    uint32_t iterations;
+    uint32_t ops_per_iteration;
+} Bench;
+
+static const Bench benches[] = {
+    {"generate_secret_code", bench_generate_secret_code, 1000000, 1},
+    {"random_code_index", bench_random_code_index, 10000000, 1},
+    {"code_rank", bench_code_rank, 10000000, 1},
+    {"reset_game_state", bench_reset_game_state, 1000000, 1},
+    {"evaluate_guess", bench_evaluate_guess, 2000000, 1},
+    {"guess_checks", bench_guess_checks, 5000000, 1},
+    {"score_reference", bench_score_reference, 4, BENCH_SPACE * BENCH_SPACE},
+    {"score_packed", bench_score_packed, 4, BENCH_SPACE * BENCH_SPACE},
+    {"score_histograms", bench_score_histograms, 4, BENCH_SPACE * BENCH_SPACE},
+    {"candidates_reset", bench_candidates_reset, 20000, 1},
+    {"candidates_filter", bench_candidates_filter, 20000, 1},
+    {"partition_scalar", bench_partition_scalar, 20000, 1},
+    {"partition_simd", bench_partition_simd, 20000, 1},
+    {"solver_first_hint", bench_solver_first_hint, 20, 1},
+    {"find_conflict", bench_find_conflict, 5000000, 1},
+    {"sprite_rasterize", bench_sprite_rasterize, 100000, HIRN_MAX_COLORS + 1},
+    {"sprite_get", bench_sprite_get, 10000000, 1},
+    {"snapshot_publish", bench_snapshot_publish, 10000000, 1},
+    {"snapshot_read", bench_snapshot_read, 10000000, 1},
+    {"random_game", bench_random_game, 100000, 1},
+};
+
+int main(int argc, char** argv) {
+    const char* filter = argc > 1 ? argv[1] : NULL;
+    furi_log_set_level(FuriLogLevelWarn);
+    srand(418);
+    seed_game_random(418);
+
+    CodeBreakerState* state = malloc(sizeof(CodeBreakerState));
+    memset(state, 0, sizeof(CodeBreakerState));
+    printf("sizeof(CodeBreakerState): %d bytes\n", (int)sizeof(CodeBreakerState));
+
+    bool verified = verify_sprites() && verify_snapshot();
+    for(int pegs = HIRN_MIN_PEGS; pegs <= HIRN_MAX_PEGS && verified; pegs++) {
+        for(int colors = HIRN_MIN_COLORS; colors <= HIRN_MAX_COLORS && verified; colors++) {
+            for(int repeat = 0; repeat < 2 && verified; repeat++) {
+                HirnVariant v = {.pegs = pegs, .colors = colors, .repeat = repeat};
+                if(!hirn_variant_valid(v)) continue;
+                select_variant(v);
+                verified = verify_variant(state);
+            }
+        }
+    }
+    if(!verified) {
+        free(state);
+        return 1;
+    }
+
+    // Benchmarks stay on the classic game, comparable across changes
+    select_variant(HIRN_VARIANT_CLASSIC);
+    furi_check(code_space == BENCH_SPACE);
+    reset_game_state(state, variant);
+
+    printf("%-24s %12s %12s\n", "benchmark", "operations", "ns/op");
+    for(size_t i = 0; i < sizeof(benches) / sizeof(benches[0]); i++) {
+        const Bench* bench = &benches[i];
+        if(filter && !strstr(bench->name, filter)) continue;
+        uint64_t start = now_ns();
+        bench->run(state, bench->iterations);
+        uint64_t elapsed = now_ns() - start;
+        double ops = (double)bench->iterations * bench->ops_per_iteration;
+        printf("%-24s %12.0f %12.2f\n", bench->name, ops, (double)elapsed / ops);
+    }
+
+    // Timings collected by the HIRN_PROFILE hooks during the runs above
+    furi_log_set_level(FuriLogLevelInfo);
+    HIRN_PROFILE_DUMP();
+
+    free(state);
+    return 0;
+}
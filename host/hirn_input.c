@@ -0,0 +1,224 @@
+// Drives the app's input handling with the event sequences the firmware
+// sends for held keys (Press, Long, Repeat..., Release), folded the way the
+// main loop folds them, and checks the state they leave behind.
+// Usage: hirn_input, exits 1 on a failed check
+
+// The app itself, for its static handle_input and fold_repeats
+#include "../hirn.c"
+
+static int failures;
+
+#define CHECK(condition)                                                              \
+    do {                                                                              \
+        if(!(condition)) {                                                            \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition);      \
+            failures++;                                                               \
+        }                                                                             \
+    } while(0)
+
+// The app as hirn_main sets it up, without the GUI, queue and clock
+static HirnApp* app_alloc(void) {
+    HirnApp* app = calloc(1, sizeof(HirnApp));
+    app->hint_budget = HINT_BUDGET_DEFAULT;
+    app->long_held = InputKeyMAX;
+    app->variant = HIRN_VARIANT_CLASSIC;
+    app->hint_thread = furi_thread_alloc_ex("HirnHint", HINT_STACK_SIZE, hint_worker, app);
+    start_round(app);
+    app->conflict = -1;
+    return app;
+}
+
+static void app_free(HirnApp* app) {
+    stop_hint(app);
+    furi_thread_free(app->hint_thread);
+    hirn_candidates_free(&app->candidates);
+    hirn_candidates_free(&app->hint_candidates);
+    free(app);
+}
+
+// One batch of input events as the main loop takes it from the queue
+static void feed(HirnApp* app, const InputEvent* inputs, size_t count) {
+    HirnEvent events[EVENT_QUEUE_SIZE];
+    furi_check(count <= EVENT_QUEUE_SIZE);
+    for(size_t i = 0; i < count; i++) {
+        events[i] = (HirnEvent){.type = EventTypeInput, .input = inputs[i]};
+    }
+    for(size_t i = 0; i < count; i++) {
+        const InputEvent* input = &events[i].input;
+        int steps = fold_repeats(events, count, &i);
+        handle_input(app, input, steps);
+    }
+}
+
+// A key held past its long press: Press, Long, then repeats Repeats that
+// arrive in one batch, then Release
+static void hold(HirnApp* app, InputKey key, size_t repeats) {
+    InputEvent inputs[EVENT_QUEUE_SIZE];
+    inputs[0] = (InputEvent){.key = key, .type = InputTypePress};
+    feed(app, inputs, 1);
+    inputs[0].type = InputTypeLong;
+    feed(app, inputs, 1);
+    for(size_t i = 0; i < repeats; i++) {
+        inputs[i] = (InputEvent){.key = key, .type = InputTypeRepeat};
+    }
+    feed(app, inputs, repeats);
+    inputs[0] = (InputEvent){.key = key, .type = InputTypeRelease};
+    feed(app, inputs, 1);
+}
+
+static void press(HirnApp* app, InputKey key) {
+    InputEvent inputs[] = {
+        {.key = key, .type = InputTypePress},
+        {.key = key, .type = InputTypeShort},
+        {.key = key, .type = InputTypeRelease},
+    };
+    feed(app, inputs, 3);
+}
+
+// Submit the classic code a b c d
+static void guess(HirnApp* app, PegColor a, PegColor b, PegColor c, PegColor d) {
+    const PegColor pegs[] = {a, b, c, d};
+    set_current_guess(&app->state, hirn_code_pack(pegs, 4));
+    press(app, InputKeyOk);
+}
+
+// Repeats of a held key fold into one event of as many steps
+static void check_folding(void) {
+    HirnEvent events[5];
+    const InputKey keys[] = {InputKeyRight, InputKeyRight, InputKeyRight, InputKeyLeft, InputKeyLeft};
+    for(int i = 0; i < 5; i++) {
+        events[i] = (HirnEvent){.type = EventTypeInput, .input = {.key = keys[i], .type = InputTypeRepeat}};
+    }
+    size_t i = 0;
+    CHECK(fold_repeats(events, 5, &i) == 3 && i == 2);
+    i = 3;
+    CHECK(fold_repeats(events, 5, &i) == 2 && i == 4);
+    events[1].input.type = InputTypePress;  // Only repeats fold
+    i = 0;
+    CHECK(fold_repeats(events, 5, &i) == 1 && i == 0);
+}
+
+// Held Right and Left move the cursor one peg per event, clamped to the code
+static void check_held_cursor(void) {
+    HirnApp* app = app_alloc();
+#ifdef HIRN_DEBUG_OVERLAY
+    move_cursor(&app->state, 3);  // A held Right toggles the overlay, see check_held_overlay
+#else
+    hold(app, InputKeyRight, 2);
+    CHECK(app->state.cursor_position == 3);  // Press, Long does nothing, two repeats
+    hold(app, InputKeyRight, 4);
+    CHECK(app->state.cursor_position == 3);
+#endif
+    hold(app, InputKeyLeft, 1);
+    CHECK(app->state.cursor_position == 1);
+    app_free(app);
+}
+
+// A held Down steps the color with every repeat while the history can't open
+static void check_held_down_colors(void) {
+    HirnApp* app = app_alloc();
+    hold(app, InputKeyDown, 3);
+    // Press and three repeats, down from COLOR_NONE through the 7 entry ring
+    CHECK(hirn_code_get(app->state.current_guess, 0) == COLOR_ORANGE - 3);
+    CHECK(!app->history_open);
+    CHECK(app->long_held == InputKeyMAX);
+    app_free(app);
+}
+
+// A held Up fills in the hint at the long press, its repeats leave it alone
+static void check_held_up_hint(void) {
+    HirnApp* app = app_alloc();
+    hold(app, InputKeyUp, 3);
+    uint16_t book_guess;
+    CHECK(hirn_book_lookup(&app->state, &book_guess));
+    CHECK(app->state.current_guess == hirn_code_from_index(book_guess, app->state.variant));
+    app_free(app);
+}
+
+#ifdef HIRN_DEBUG_OVERLAY
+// A held Right toggles the overlay and leaves the cursor and budget alone
+static void check_held_overlay(void) {
+    HirnApp* app = app_alloc();
+    hold(app, InputKeyRight, 2);
+    CHECK(app->debug_overlay);
+    CHECK(app->state.cursor_position == 0);
+    move_cursor(&app->state, 3);
+    hold(app, InputKeyRight, 2);  // The press doesn't move off the last peg
+    CHECK(!app->debug_overlay);
+    CHECK(app->state.cursor_position == 3);
+
+    press(app, InputKeyBack);
+    uint8_t budget = app->hint_budget;
+    hold(app, InputKeyRight, 2);
+    CHECK(app->debug_overlay);
+    CHECK(app->hint_budget == budget);
+    app_free(app);
+}
+#endif
+
+// A hint taken early reaches the app even when the queue was full at first
+static void check_taken_hint(void) {
+    HirnApp* app = app_alloc();
+    app->event_queue = furi_message_queue_alloc(1, sizeof(HirnEvent));
+    HirnEvent event = {.type = EventTypeClock};
+    furi_message_queue_put(app->event_queue, &event, 0);
+    guess(app, COLOR_RED, COLOR_RED, COLOR_GREEN, COLOR_GREEN);
+    guess(app, COLOR_BLUE, COLOR_BLUE, COLOR_YELLOW, COLOR_YELLOW);  // Past the opening book
+    app->hint_budget = HINT_BUDGET_COUNT - 1;  // Unlimited
+    start_hint(app);
+    CHECK(app->hint_running);
+    take_hint(app);
+    furi_delay_ms(50);  // The worker's first puts time out meanwhile
+
+    furi_message_queue_get(app->event_queue, &event, 0);
+    CHECK(furi_message_queue_get(app->event_queue, &event, 1000) == FuriStatusOk);
+    CHECK(event.type == EventTypeHint && event.hint.found);
+    apply_hint(app, &event.hint);
+    CHECK(!app->hint_running);
+    furi_message_queue_free(app->event_queue);
+    app_free(app);
+}
+
+// A held Down opens the history and keeps the color, a second hold glides
+// through it and Back returns to the board
+static void check_history(void) {
+    HirnApp* app = app_alloc();
+    for(int attempt = 0; attempt < 10; attempt++) {
+        guess(app, COLOR_RED + attempt % 6, COLOR_GREEN, COLOR_BLUE, COLOR_YELLOW + attempt % 3);
+    }
+    CHECK(app->state.attempts_used == 10);
+    HirnCode before = app->state.current_guess;
+    hold(app, InputKeyDown, 3);
+    CHECK(app->history_open);
+    CHECK(app->state.current_guess == before);
+    CHECK(app->history_scroll == 0);  // The hold that opened it doesn't scroll
+
+    hold(app, InputKeyDown, 3);
+    CHECK(app->history_open);
+    CHECK(app->history_scroll == HIRN_HISTORY_ROW_HEIGHT + 3 * HISTORY_GLIDE_PX);
+    hold(app, InputKeyUp, 2);
+    CHECK(app->history_open);
+    CHECK(app->history_scroll == HIRN_HISTORY_ROW_HEIGHT - 2 * HISTORY_GLIDE_PX);
+
+    press(app, InputKeyBack);
+    CHECK(!app->history_open);
+    CHECK(app->state.state == STATE_PLAYING);
+    CHECK(app->state.current_guess == before);
+    app_free(app);
+}
+
+int main(void) {
+    furi_log_set_level(FuriLogLevelWarn);
+    seed_game_random(418);
+    check_folding();
+    check_held_cursor();
+    check_held_down_colors();
+    check_held_up_hint();
+#ifdef HIRN_DEBUG_OVERLAY
+    check_held_overlay();
+#endif
+    check_taken_hint();
+    check_history();
+    printf("input: %d failed checks\n", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,310 @@
+// Renders the game screen into the headless canvas, for golden images and
+// for timing the drawing code.
+// Usage: hirn_render check|update|bench [golden-dir]
+//   check   compare every scene with <golden-dir>/<scene>.pbm, exit 1 on a difference
+//   update  (re)write the golden images
+//   bench   time hirn_view_draw per scene, with the background redrawn and copied
+
+#include <furi.h>
+#include <gui/gui.h>
+#include <time.h>
+
+#include "hirn_game.h"
+#include "hirn_candidates.h"
+#include "hirn_view.h"
+
+#define FRAMES 20000  // Per scene in bench mode
+
+typedef struct {
+    HirnRenderState render;
+    HirnCandidates candidates;
+} Scene;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static HirnCode code(PegColor a, PegColor b, PegColor c, PegColor d) {
+    const PegColor pegs[] = {a, b, c, d};
+    return hirn_code_pack(pegs, 4);
+}
+
+// Fresh round of variant, same secret every time
+static void start_variant(Scene* scene, HirnVariant variant) {
+    hirn_candidates_free(&scene->candidates);
+    memset(scene, 0, sizeof(Scene));
+    seed_game_random(418);
+    reset_game_state(&scene->render.state, variant);
+    hirn_candidates_reset(&scene->candidates, variant);
+    scene->render.hint_budget_ms = 500;
+    scene->render.hint_percent = -1;
+    scene->render.settings_variant = variant;
+}
+
+static void start(Scene* scene) {
+    start_variant(scene, HIRN_VARIANT_CLASSIC);
+}
+
+static void play(Scene* scene, HirnCode guess) {
+    CodeBreakerState* state = &scene->render.state;
+    set_current_guess(state, guess);
+    evaluate_guess(state);
+    int last = state->attempts_used - 1;
+    hirn_candidates_filter(&scene->candidates, hirn_code_from_index(state->guess_history[last], state->variant),
+                           state->feedback_history[last]);
+}
+
+// Fix what a frame derives from the clock and the game, like publish_render
+static void finish(Scene* scene, uint32_t elapsed_ms) {
+    CodeBreakerState* state = &scene->render.state;
+    state->elapsed_time = elapsed_ms;
+    state->start_time = furi_get_tick();  // Drawn within milliseconds, the second stays put
+    scene->render.candidates = scene->candidates.count;
+    scene->render.conflict = find_conflicting_attempt(state);
+}
+
+static void scene_start(Scene* scene) {
+    start(scene);
+    finish(scene, 0);
+}
+
+// Two attempts in, half of the next guess chosen
+static void scene_guessing(Scene* scene) {
+    start(scene);
+    play(scene, code(COLOR_RED, COLOR_GREEN, COLOR_BLUE, COLOR_YELLOW));
+    play(scene, code(COLOR_PURPLE, COLOR_ORANGE, COLOR_RED, COLOR_GREEN));
+    set_current_guess(&scene->render.state, code(COLOR_BLUE, COLOR_RED, COLOR_NONE, COLOR_NONE));
+    move_cursor(&scene->render.state, 2);
+    finish(scene, 83000);
+}
+
+// A complete guess that contradicts the first attempt
+static void scene_conflict(Scene* scene) {
+    start(scene);
+    play(scene, code(COLOR_RED, COLOR_GREEN, COLOR_BLUE, COLOR_YELLOW));
+    set_current_guess(&scene->render.state, code(COLOR_ORANGE, COLOR_ORANGE, COLOR_ORANGE, COLOR_ORANGE));
+    finish(scene, 42000);
+}
+
+// A complete, consistent guess ready to send
+static void scene_complete(Scene* scene) {
+    start(scene);
+    play(scene, code(COLOR_RED, COLOR_GREEN, COLOR_BLUE, COLOR_YELLOW));
+    for(uint16_t index = 0; index < hirn_code_space(HIRN_VARIANT_CLASSIC); index++) {
+        if(hirn_candidates_contains(&scene->candidates, index)) {
+            set_current_guess(&scene->render.state, hirn_code_from_index(index, HIRN_VARIANT_CLASSIC));
+            break;
+        }
+    }
+    finish(scene, 61000);
+}
+
+static void scene_hint(Scene* scene) {
+    scene_guessing(scene);
+    scene->render.hint_running = true;
+    scene->render.hint_percent = 42;
+}
+
+static void scene_paused(Scene* scene) {
+    scene_guessing(scene);
+    pause_game(&scene->render.state);
+    scene->render.has_last_hint = true;
+    scene->render.last_hint.duration_ms = 37;
+    finish(scene, 83000);
+}
+
+static void scene_won(Scene* scene) {
+    start(scene);
+    play(scene, code(COLOR_RED, COLOR_GREEN, COLOR_BLUE, COLOR_YELLOW));
+    play(scene, scene->render.state.secret_code);
+    finish(scene, 125000);
+}
+
+static void scene_lost(Scene* scene) {
+    start(scene);
+    for(int i = 0; i < MAX_ATTEMPTS; i++) {
+        play(scene, hirn_code_from_index((i * 97) % hirn_code_space(HIRN_VARIANT_CLASSIC), HIRN_VARIANT_CLASSIC));
+    }
+    finish(scene, 754000);
+}
+
+static void scene_timeout(Scene* scene) {
+    scene_guessing(scene);
+    scene->render.state.state = STATE_LOST;
+    finish(scene, MAX_TIME_MS);
+}
+
+static void scene_reveal(Scene* scene) {
+    scene_guessing(scene);
+    toggle_reveal(&scene->render.state);
+    finish(scene, 83000);
+}
+
+// Three attempts, the guess contradicting the first
+static void scene_history(Scene* scene) {
+    scene_conflict(scene);
+    play(scene, code(COLOR_PURPLE, COLOR_ORANGE, COLOR_RED, COLOR_GREEN));
+    play(scene, code(COLOR_BLUE, COLOR_BLUE, COLOR_YELLOW, COLOR_RED));
+    finish(scene, 42000);
+    scene->render.history_open = true;
+}
+
+// All attempts, scrolled to a row cut by the title bar
+static void scene_history_scrolled(Scene* scene) {
+    scene_lost(scene);
+    scene->render.history_open = true;
+    scene->render.history_scroll = 2 * HIRN_HISTORY_ROW_HEIGHT + 5;
+}
+
+// Settings with a bigger variant chosen than the one being played
+static void scene_settings(Scene* scene) {
+    scene_paused(scene);
+    scene->render.settings_open = true;
+    scene->render.settings_row = HirnSettingsRowColors;
+    scene->render.settings_variant = (HirnVariant){.pegs = 5, .colors = 8, .repeat = true};
+}
+
+// The widest board: six pegs of six colors, all of them in use
+static void scene_six_pegs(Scene* scene) {
+    HirnVariant variant = {.pegs = 6, .colors = 6, .repeat = true};
+    start_variant(scene, variant);
+    const PegColor first[] = {COLOR_RED, COLOR_GREEN, COLOR_BLUE, COLOR_YELLOW, COLOR_PURPLE, COLOR_ORANGE};
+    play(scene, hirn_code_pack(first, 6));
+    const PegColor guess[] = {COLOR_ORANGE, COLOR_ORANGE, COLOR_RED, COLOR_NONE, COLOR_GREEN, COLOR_NONE};
+    set_current_guess(&scene->render.state, hirn_code_pack(guess, 6));
+    move_cursor(&scene->render.state, 5);
+    finish(scene, 19000);
+}
+
+// Five pegs of eight colors, showing the two extra patterns
+static void scene_five_pegs(Scene* scene) {
+    HirnVariant variant = {.pegs = 5, .colors = 8, .repeat = false};
+    start_variant(scene, variant);
+    const PegColor first[] = {COLOR_CYAN, COLOR_PINK, COLOR_RED, COLOR_GREEN, COLOR_BLUE};
+    play(scene, hirn_code_pack(first, 5));
+    const PegColor guess[] = {COLOR_PINK, COLOR_CYAN, COLOR_NONE, COLOR_NONE, COLOR_NONE};
+    set_current_guess(&scene->render.state, hirn_code_pack(guess, 5));
+    move_cursor(&scene->render.state, 1);
+    finish(scene, 7000);
+}
+
+// Three pegs: the classic layout with a peg less
+static void scene_three_pegs(Scene* scene) {
+    HirnVariant variant = {.pegs = 3, .colors = 4, .repeat = false};
+    start_variant(scene, variant);
+    const PegColor first[] = {COLOR_RED, COLOR_GREEN, COLOR_BLUE};
+    play(scene, hirn_code_pack(first, 3));
+    finish(scene, 3000);
+}
+
+// The history of six pegs, with the narrower pegs
+static void scene_six_pegs_history(Scene* scene) {
+    HirnVariant variant = {.pegs = 6, .colors = 6, .repeat = true};
+    start_variant(scene, variant);
+    for(int i = 0; i < 5; i++) {
+        play(scene, hirn_code_from_index((i * 7919) % hirn_code_space(variant), variant));
+    }
+    finish(scene, 64000);
+    scene->render.history_open = true;
+}
+
+static const struct {
+    const char* name;
+    void (*setup)(Scene* scene);
+} scenes[] = {
+    {"start", scene_start},
+    {"guessing", scene_guessing},
+    {"conflict", scene_conflict},
+    {"complete", scene_complete},
+    {"hint", scene_hint},
+    {"paused", scene_paused},
+    {"won", scene_won},
+    {"lost", scene_lost},
+    {"timeout", scene_timeout},
+    {"reveal", scene_reveal},
+    {"history", scene_history},
+    {"history_scrolled", scene_history_scrolled},
+    {"settings", scene_settings},
+    {"six_pegs", scene_six_pegs},
+    {"five_pegs", scene_five_pegs},
+    {"three_pegs", scene_three_pegs},
+    {"six_pegs_history", scene_six_pegs_history},
+};
+
+#define SCENE_COUNT (sizeof(scenes) / sizeof(scenes[0]))
+
+int main(int argc, char** argv) {
+    const char* mode = argc > 1 ? argv[1] : "check";
+    const char* dir = argc > 2 ? argv[2] : "golden";
+    bool update = !strcmp(mode, "update");
+    bool bench = !strcmp(mode, "bench");
+    if(!update && !bench && strcmp(mode, "check")) {
+        fprintf(stderr, "Usage: %s check|update|bench [golden-dir]\n", argv[0]);
+        return 2;
+    }
+    furi_log_set_level(FuriLogLevelWarn);
+
+    Canvas* canvas = canvas_host_alloc();
+    static HirnViewCache view;
+    static Scene scene;
+    int failures = 0;
+    for(size_t i = 0; i < SCENE_COUNT; i++) {
+        scenes[i].setup(&scene);
+        char path[256];
+        snprintf(path, sizeof(path), "%s/%s.pbm", dir, scenes[i].name);
+
+        if(bench) {
+            uint64_t begin = now_ns();
+            for(int frame = 0; frame < FRAMES; frame++) {
+                view.background_valid = false;
+                hirn_view_draw(canvas, &scene.render, &view);
+            }
+            uint64_t drawn = now_ns() - begin;
+            begin = now_ns();
+            for(int frame = 0; frame < FRAMES; frame++) {
+                hirn_view_draw(canvas, &scene.render, &view);
+            }
+            uint64_t copied = now_ns() - begin;
+            printf("%-18s %8.0f ns/frame drawn %8.0f ns/frame copied\n", scenes[i].name,
+                   (double)drawn / FRAMES, (double)copied / FRAMES);
+            continue;
+        }
+
+        // Draw the background, then once more from the cache: same frame
+        static uint8_t drawn[128 * 64 / 8];
+        view.background_valid = false;
+        hirn_view_draw(canvas, &scene.render, &view);
+        memcpy(drawn, canvas_get_buffer(canvas), sizeof(drawn));
+        hirn_view_draw(canvas, &scene.render, &view);
+        if(memcmp(drawn, canvas_get_buffer(canvas), sizeof(drawn))) {
+            printf("%-18s cached background gives a different frame\n", scenes[i].name);
+            failures++;
+            continue;
+        }
+        if(update) {
+            if(!canvas_host_write_pbm(canvas, path)) {
+                printf("%-18s can't write %s\n", scenes[i].name, path);
+                failures++;
+            }
+            continue;
+        }
+        int32_t diff = canvas_host_diff_pbm(canvas, path);
+        if(diff) {
+            failures++;
+            if(diff < 0) {
+                printf("%-18s can't read %s\n", scenes[i].name, path);
+            } else {
+                // Keep the new frame next to the golden one for a look
+                snprintf(path, sizeof(path), "%s/%s.new.pbm", dir, scenes[i].name);
+                canvas_host_write_pbm(canvas, path);
+                printf("%-18s %ld pixels differ, see %s\n", scenes[i].name, (long)diff, path);
+            }
+        } else {
+            printf("%-18s ok\n", scenes[i].name);
+        }
+    }
+    canvas_host_free(canvas);
+    return failures ? 1 : 0;
+}
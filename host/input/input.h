@@ -0,0 +1,34 @@
+#pragma once
+
+#include <stdint.h>
+
+// ============================================================================
+// Stand-in for the firmware's input events, same keys and types.
+// ============================================================================
+
+typedef enum {
+    InputKeyUp,
+    InputKeyDown,
+    InputKeyRight,
+    InputKeyLeft,
+    InputKeyOk,
+    InputKeyBack,
+    InputKeyMAX,
+} InputKey;
+
+// A held key sends Press, Long after a while, then Repeats until Release.
+// A key released before Long also sends Short.
+typedef enum {
+    InputTypePress,
+    InputTypeRelease,
+    InputTypeShort,
+    InputTypeLong,
+    InputTypeRepeat,
+    InputTypeMAX,
+} InputType;
+
+typedef struct {
+    uint32_t sequence;
+    InputKey key;
+    InputType type;
+} InputEvent;
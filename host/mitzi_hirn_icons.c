@@ -0,0 +1,19 @@
+// images/*.png converted to XBM like the firmware's asset packer does:
+// a pixel is set where the image is dark. Redo by hand if the images change.
+
+#include "mitzi_hirn_icons.h"
+
+static const uint8_t icon_10x10_data[] = {
+    0x78, 0x00, 0x94, 0x00, 0x42, 0x01, 0x2e, 0x01, 0xc1, 0x02,
+    0x57, 0x02, 0x91, 0x03, 0x39, 0x02, 0xc6, 0x01, 0x00, 0x00,
+};
+const Icon I_icon_10x10 = {.width = 10, .height = 10, .data = icon_10x10_data};
+
+static const uint8_t back_data[] = {0x0c, 0x06, 0x3f, 0x46, 0x4c, 0x40, 0x3e};
+const Icon I_back = {.width = 7, .height = 7, .data = back_data};
+
+static const uint8_t arrows_data[] = {
+    0x10, 0x00, 0x28, 0x00, 0x00, 0x00, 0xc6, 0x00, 0x83, 0x01,
+    0xc6, 0x00, 0x00, 0x00, 0x28, 0x00, 0x10, 0x00, 0x00, 0x00,
+};
+const Icon I_arrows = {.width = 10, .height = 10, .data = arrows_data};
@@ -0,0 +1,8 @@
+#pragma once
+
+#include <gui/gui.h>
+
+// Icons of images/, generated by the firmware's asset packer on the device
+extern const Icon I_icon_10x10;
+extern const Icon I_back;
+extern const Icon I_arrows;